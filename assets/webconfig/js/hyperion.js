@@ -333,7 +333,7 @@ function requestServerConfigReload()
 function requestLedColorsStart()
 {
   window.ledStreamActive=true;
-  sendToHyperion("ledcolors", "ledstream-start");
+  sendToHyperion("ledcolors", "ledstream-start", '"format":"base64","delta":true');
 }
 
 function requestLedColorsStop()
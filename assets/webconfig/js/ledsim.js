@@ -264,10 +264,33 @@ $(document).ready(function () {
       requestLedColorsStop();
     }
     else {
-      printLedsToCanvas(event.response.result.leds)
+      printLedsToCanvas(decodeLedStream(event.response.result));
     }
   });
 
+  // decode compact (base64/delta) led streams into a flat rgb array, plain json arrays pass through
+  var streamedLeds = [];
+  function decodeLedStream(result) {
+    if (result.format !== "base64")
+      return result.leds;
+
+    var raw = atob(result.leds);
+    if (!result.delta || streamedLeds.length != result.count * 3) {
+      streamedLeds = new Array(raw.length);
+      for (var i = 0; i < raw.length; i++)
+        streamedLeds[i] = raw.charCodeAt(i);
+    }
+    else {
+      for (var j = 0; j + 4 < raw.length; j += 5) {
+        var pos = ((raw.charCodeAt(j) << 8) | raw.charCodeAt(j + 1)) * 3;
+        streamedLeds[pos] = raw.charCodeAt(j + 2);
+        streamedLeds[pos + 1] = raw.charCodeAt(j + 3);
+        streamedLeds[pos + 2] = raw.charCodeAt(j + 4);
+      }
+    }
+    return streamedLeds;
+  }
+
   // ------------------------------------------------------------------
   $(window.hyperion).on("cmd-ledcolors-imagestream-update", function (event) {
     setClassByBool('#leds_toggle_live_video', window.imageStreamActive, "btn-danger", "btn-success");
@@ -20,8 +20,10 @@ sudo apt-get install                 \
 	libcec-dev                   \
 	libxcb-util0-dev             \
 	libxcb-randr0-dev            \
+	libxcb-damage0-dev           \
 	libxrandr-dev                \
 	libxrender-dev               \
+	libxdamage-dev               \
 	libavahi-core-dev            \
 	libavahi-compat-libdnssd-dev \
 	libssl-dev                   \
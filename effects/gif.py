@@ -1,4 +1,4 @@
-import hyperion, time
+import hyperion
 
 # Get the parameters
 imageData = hyperion.args.get('url') if hyperion.args.get('imageSource', "") == "url" else hyperion.args.get('file')
@@ -10,7 +10,6 @@ cropRight = int(hyperion.args.get('cropRight', 0))
 cropBottom = int(hyperion.args.get('cropBottom', 0))
 grayscale = bool(hyperion.args.get('grayscale', False))
 
-sleepTime = 1./framesPerSecond
 imageFrameList = []
 
 if imageData:
@@ -24,4 +23,4 @@ while not hyperion.abort() and imageFrameList:
 	for image in imageFrameList:
 		if not hyperion.abort():
 			hyperion.setImage(image["imageWidth"], image["imageHeight"], image["imageData"])
-			time.sleep(sleepTime)
+			hyperion.waitForNextFrame(framesPerSecond)
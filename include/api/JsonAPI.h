@@ -126,6 +126,15 @@ private:
 	/// the current streaming led values
 	std::vector<ColorRgb> _currentLedValues;
 
+	/// the led values of the last streamed update, used to skip unchanged frames and to build deltas
+	std::vector<ColorRgb> _lastStreamedLedValues;
+
+	/// stream led colors as base64 encoded packed RGB instead of a JSON array
+	bool _ledStreamCompact;
+
+	/// stream only the leds that changed since the last update (requires _ledStreamCompact)
+	bool _ledStreamDelta;
+
 	///
 	/// @brief Handle the switches of Hyperion instances
 	/// @param instance the instance to switch
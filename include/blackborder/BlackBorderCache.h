@@ -0,0 +1,90 @@
+#pragma once
+
+// QT includes
+#include <QMutex>
+#include <QVector>
+
+// Utils includes
+#include <utils/Image.h>
+#include <utils/ColorRgb.h>
+
+// Local Hyperion includes
+#include "BlackBorderDetector.h"
+
+#include <atomic>
+
+namespace hyperion
+{
+	///
+	/// Process wide cache of black-border detection results.
+	/// A grabbed frame is fanned out to all running Hyperion instances as copies of the same image data.
+	/// Instances with the same detector configuration look up the border detected by the first instance
+	/// which processed the frame instead of running the detection on the same pixels again.
+	///
+	class BlackBorderCache
+	{
+	public:
+		static BlackBorderCache* getInstance()
+		{
+			static BlackBorderCache instance;
+			return & instance;
+		}
+
+		BlackBorderCache(BlackBorderCache const&) = delete;
+		void operator=(BlackBorderCache const&) = delete;
+
+		///
+		/// Enable or disable sharing of detection results, e.g. depending on the number of running instances.
+		/// Disabling the cache releases all cached frames.
+		///
+		/// @param enable The new state
+		///
+		void setEnabled(bool enable);
+
+		///
+		/// @return True if detection results are shared across instances
+		///
+		bool isEnabled() const { return _enabled; }
+
+		///
+		/// Get the border detected for the given frame by another instance with the same configuration
+		///
+		/// @param[in]  image     The frame to look up
+		/// @param[in]  threshold The detector threshold
+		/// @param[in]  mode      The detection mode
+		/// @param[out] border    The cached border
+		///
+		/// @return True if a cached border was found
+		///
+		bool lookup(const Image<ColorRgb>& image, double threshold, DetectionMode mode, BlackBorder& border) const;
+
+		///
+		/// Store the border detected for the given frame. Results of previous frames are dropped.
+		///
+		/// @param image     The frame the border was detected on
+		/// @param threshold The detector threshold
+		/// @param mode      The detection mode
+		/// @param border    The detected border
+		///
+		void insert(const Image<ColorRgb>& image, double threshold, DetectionMode mode, const BlackBorder& border);
+
+	private:
+		BlackBorderCache();
+
+		/// Maximum number of distinct detector configurations cached for a frame
+		static const int MAX_ENTRIES;
+
+		struct Entry
+		{
+			/// Reference to the frame, keeps the image data alive so its identity can't be reused
+			Image<ColorRgb> image;
+			double threshold;
+			DetectionMode mode;
+			BlackBorder border;
+		};
+
+		mutable QMutex _mutex;
+		std::atomic<bool> _enabled;
+		QVector<Entry> _entries;
+	};
+} // end namespace hyperion
@@ -3,6 +3,7 @@
 
 // Utils includes
 #include <utils/Image.h>
+#include <utils/ColorRgb.h>
 
 namespace hyperion
 {
@@ -38,6 +39,17 @@ namespace hyperion
 		}
 	};
 
+	///
+	/// The black-border detection modes
+	///
+	enum class DetectionMode
+	{
+		DEFAULT,
+		CLASSIC,
+		OSD,
+		LETTERBOX
+	};
+
 	///
 	/// The BlackBorderDetector performs detection of black-borders on a single image.
 	/// The detector will search for the upper left corner of the picture in the frame.
@@ -79,36 +91,19 @@ namespace hyperion
 			int xCenter = width / 2;
 			int yCenter = height / 2;
 
-
-			int firstNonBlackXPixelIndex = -1;
-			int firstNonBlackYPixelIndex = -1;
-
-			width--; // remove 1 pixel to get end pixel index
-			height--;
-
 			// find first X pixel of the image
-			for (int x = 0; x < width33percent; ++x)
-			{
-				if (!isBlack(image((width - x), yCenter))
-					|| !isBlack(image(x, height33percent))
-				 	|| !isBlack(image(x, height66percent)))
-				{
-					firstNonBlackXPixelIndex = x;
-					break;
-				}
-			}
+			int firstNonBlackXPixelIndex = -1;
+			int limit = width33percent;
+			narrowScan(firstNonBlackXPixelIndex, limit, scanRow(image, yCenter, limit, true));
+			narrowScan(firstNonBlackXPixelIndex, limit, scanRow(image, height33percent, limit, false));
+			narrowScan(firstNonBlackXPixelIndex, limit, scanRow(image, height66percent, limit, false));
 
 			// find first Y pixel of the image
-			for (int y = 0; y < height33percent; ++y)
-			{
-				if (!isBlack(image(xCenter, (height - y)))
-					|| !isBlack(image(width33percent, y))
-					|| !isBlack(image(width66percent, y)))
-				{
-					firstNonBlackYPixelIndex = y;
-					break;
-				}
-			}
+			int firstNonBlackYPixelIndex = -1;
+			limit = height33percent;
+			narrowScan(firstNonBlackYPixelIndex, limit, scanColumn(image, xCenter, limit, true));
+			narrowScan(firstNonBlackYPixelIndex, limit, scanColumn(image, width33percent, limit, false));
+			narrowScan(firstNonBlackYPixelIndex, limit, scanColumn(image, width66percent, limit, false));
 
 			// Construct result
 			BlackBorder detectedBorder;
@@ -190,40 +185,24 @@ namespace hyperion
 			int height66percent = height33percent * 2;
 			int yCenter = height / 2;
 
-
+			// find first X pixel of the image
 			int firstNonBlackXPixelIndex = -1;
-			int firstNonBlackYPixelIndex = -1;
+			int limit = width33percent;
+			narrowScan(firstNonBlackXPixelIndex, limit, scanRow(image, yCenter, limit, true));
+			narrowScan(firstNonBlackXPixelIndex, limit, scanRow(image, height33percent, limit, false));
+			narrowScan(firstNonBlackXPixelIndex, limit, scanRow(image, height66percent, limit, false));
 
-			width--; // remove 1 pixel to get end pixel index
-			height--;
-
-			// find first X pixel of the image
-			int x;
-			for (x = 0; x < width33percent; ++x)
-			{
-				if (!isBlack(image((width - x), yCenter))
-					|| !isBlack(image(x, height33percent))
-					|| !isBlack(image(x, height66percent)))
-				{
-					firstNonBlackXPixelIndex = x;
-					break;
-				}
-			}
+			// without a detected X position the columns at 33% are checked
+			const int x = (firstNonBlackXPixelIndex == -1) ? width33percent : firstNonBlackXPixelIndex;
 
 			// find first Y pixel of the image
-			for (int y = 0; y < height33percent; ++y)
-			{
-				// left side top + left side bottom + right side top  +  right side bottom
-				if (!isBlack(image(x, y))
-					|| !isBlack(image(x, (height - y)))
-					|| !isBlack(image((width - x), y))
-					|| !isBlack(image((width - x), (height - y))))
-				{
-//					std::cout << "y " << y << " lt " << int(isBlack(color1)) << " lb " << int(isBlack(color2)) << " rt " << int(isBlack(color3)) << " rb " << int(isBlack(color4)) << std::endl;
-					firstNonBlackYPixelIndex = y;
-					break;
-				}
-			}
+			// left side top + left side bottom + right side top  +  right side bottom
+			int firstNonBlackYPixelIndex = -1;
+			limit = height33percent;
+			narrowScan(firstNonBlackYPixelIndex, limit, scanColumn(image, x, limit, false));
+			narrowScan(firstNonBlackYPixelIndex, limit, scanColumn(image, x, limit, true));
+			narrowScan(firstNonBlackYPixelIndex, limit, scanColumn(image, (width - 1 - x), limit, false));
+			narrowScan(firstNonBlackYPixelIndex, limit, scanColumn(image, (width - 1 - x), limit, true));
 
 			// Construct result
 			BlackBorder detectedBorder;
@@ -249,24 +228,14 @@ namespace hyperion
 			int width75percent = width25percent * 3;
 			int xCenter = width / 2;
 
-
-			int firstNonBlackYPixelIndex = -1;
-
-			height--; // remove 1 pixel to get end pixel index
-
 			// find first Y pixel of the image
-			for (int y = 0; y < height33percent; ++y)
-			{
-				if (!isBlack(image(xCenter, y))
-					|| !isBlack(image(width25percent, y))
-					|| !isBlack(image(width75percent, y))
-					|| !isBlack(image(width25percent, (height - y)))
-					|| !isBlack(image(width75percent, (height - y))))
-				{
-					firstNonBlackYPixelIndex = y;
-					break;
-				}
-			}
+			int firstNonBlackYPixelIndex = -1;
+			int limit = height33percent;
+			narrowScan(firstNonBlackYPixelIndex, limit, scanColumn(image, xCenter, limit, false));
+			narrowScan(firstNonBlackYPixelIndex, limit, scanColumn(image, width25percent, limit, false));
+			narrowScan(firstNonBlackYPixelIndex, limit, scanColumn(image, width75percent, limit, false));
+			narrowScan(firstNonBlackYPixelIndex, limit, scanColumn(image, width25percent, limit, true));
+			narrowScan(firstNonBlackYPixelIndex, limit, scanColumn(image, width75percent, limit, true));
 
 			// Construct result
 			BlackBorder detectedBorder;
@@ -280,6 +249,105 @@ namespace hyperion
 
 	private:
 
+		///
+		/// Takes over the result of a probe line. The remaining probe lines only have to be scanned up to
+		/// the first non black pixel found so far.
+		///
+		/// @param[in,out] firstNonBlack  The first non black pixel index over all probe lines
+		/// @param[in,out] limit          The number of pixels to scan on the remaining probe lines
+		/// @param[in]     found          The result of the probe line
+		///
+		static inline void narrowScan(int & firstNonBlack, int & limit, int found)
+		{
+			if (found != -1)
+			{
+				firstNonBlack = found;
+				limit = found;
+			}
+		}
+
+		///
+		/// Scans a row of the image for the first non black pixel
+		///
+		/// @param[in] image     The image to scan
+		/// @param[in] y         The row index
+		/// @param[in] limit     The number of pixels to scan
+		/// @param[in] fromRight True to scan from the right side, else from the left side
+		///
+		/// @return The distance of the first non black pixel from the scanned side (-1 if all pixels are black)
+		///
+		template <typename Pixel_T>
+		int scanRow(const Image<Pixel_T> & image, int y, int limit, bool fromRight) const
+		{
+			const Pixel_T * row = image.memptr() + y * image.width();
+			const int last = image.width() - 1;
+			for (int i = 0; i < limit; ++i)
+			{
+				if (!isBlack(row[fromRight ? (last - i) : i]))
+				{
+					return i;
+				}
+			}
+			return -1;
+		}
+
+		///
+		/// Scans a row of a RGB image for the first non black pixel.
+		/// The row is scanned as plain bytes with SIMD, a pixel is not black as soon as one of its channels reaches the threshold.
+		///
+		int scanRow(const Image<ColorRgb> & image, int y, int limit, bool fromRight) const
+		{
+			if (limit <= 0)
+			{
+				return -1;
+			}
+
+			const uint8_t * row = reinterpret_cast<const uint8_t *>(image.memptr() + y * image.width());
+			if (fromRight)
+			{
+				const int index = lastNonBlackByte(row + 3 * (image.width() - limit), 3 * limit);
+				return (index == -1) ? -1 : (limit - 1 - index / 3);
+			}
+
+			const int index = firstNonBlackByte(row, 3 * limit);
+			return (index == -1) ? -1 : (index / 3);
+		}
+
+		///
+		/// Scans a column of the image for the first non black pixel
+		///
+		/// @param[in] image      The image to scan
+		/// @param[in] x          The column index
+		/// @param[in] limit      The number of pixels to scan
+		/// @param[in] fromBottom True to scan from the bottom, else from the top
+		///
+		/// @return The distance of the first non black pixel from the scanned side (-1 if all pixels are black)
+		///
+		template <typename Pixel_T>
+		int scanColumn(const Image<Pixel_T> & image, int x, int limit, bool fromBottom) const
+		{
+			const int step = fromBottom ? -int(image.width()) : int(image.width());
+			const Pixel_T * pixel = image.memptr() + (fromBottom ? (image.height() - 1) * image.width() : 0) + x;
+			for (int i = 0; i < limit; ++i)
+			{
+				if (!isBlack(pixel[i * step]))
+				{
+					return i;
+				}
+			}
+			return -1;
+		}
+
+		///
+		/// @return Index of the first byte reaching the threshold (-1 if none)
+		///
+		int firstNonBlackByte(const uint8_t * data, int size) const;
+
+		///
+		/// @return Index of the last byte reaching the threshold (-1 if none)
+		///
+		int lastNonBlackByte(const uint8_t * data, int size) const;
+
 		///
 		/// Checks if a given color is considered black and therefore could be part of the border.
 		///
@@ -10,6 +10,7 @@
 
 // Local Hyperion includes
 #include "BlackBorderDetector.h"
+#include "BlackBorderCache.h"
 
 class Hyperion;
 
@@ -37,6 +38,12 @@ namespace hyperion
 		///
 		bool enabled() const;
 
+		///
+		/// Return whether further frames with the same border would not change the current border
+		/// @return True if the detector is disabled or the last detected border is the current one
+		///
+		bool isSettled() const;
+
 		///
 		/// Set activation state of black border detector
 		/// @param enable current state
@@ -74,15 +81,8 @@ namespace hyperion
 				return true;
 			}
 
-			if (_detectionMode == "default") {
-				imageBorder = _detector->process(image);
-			} else if (_detectionMode == "classic") {
-				imageBorder = _detector->process_classic(image);
-			} else if (_detectionMode == "osd") {
-				imageBorder = _detector->process_osd(image);
-			} else if (_detectionMode == "letterbox") {
-				imageBorder = _detector->process_letterbox(image);
-			}
+			imageBorder = detectBorder(image);
+
 			// add blur to the border
 			if (imageBorder.horizontalSize > 0)
 			{
@@ -109,7 +109,58 @@ namespace hyperion
 		///
 		void handleCompStateChangeRequest(hyperion::Components component, bool enable);
 
+	public:
+		///
+		/// @brief Resolve a detection mode name from the settings
+		/// @param mode The name of the mode
+		/// @return The mode, default for unknown names
+		///
+		static DetectionMode detectionModeFromString(const QString& mode);
+
 	private:
+		///
+		/// Runs the detector of the configured mode on the given image
+		///
+		/// @param image The image to process
+		///
+		/// @return The border of the single image
+		///
+		template <typename Pixel_T>
+		BlackBorder detectBorder(const Image<Pixel_T> & image)
+		{
+			BlackBorder imageBorder;
+			imageBorder.horizontalSize = 0;
+			imageBorder.verticalSize = 0;
+
+			switch (_detectionMode)
+			{
+				case DetectionMode::DEFAULT: imageBorder = _detector->process(image); break;
+				case DetectionMode::CLASSIC: imageBorder = _detector->process_classic(image); break;
+				case DetectionMode::OSD: imageBorder = _detector->process_osd(image); break;
+				case DetectionMode::LETTERBOX: imageBorder = _detector->process_letterbox(image); break;
+			}
+			return imageBorder;
+		}
+
+		///
+		/// Captured frames are shared by all instances, reuse the border another instance
+		/// with the same detector configuration already detected for this frame
+		///
+		/// @param image The image to process
+		///
+		/// @return The border of the single image
+		///
+		BlackBorder detectBorder(const Image<ColorRgb> & image)
+		{
+			BlackBorder imageBorder;
+			if (!BlackBorderCache::getInstance()->lookup(image, _oldThreshold, _detectionMode, imageBorder))
+			{
+				imageBorder = detectBorder<ColorRgb>(image);
+				BlackBorderCache::getInstance()->insert(image, _oldThreshold, _detectionMode, imageBorder);
+			}
+			return imageBorder;
+		}
+
 		/// Hyperion instance
 		Hyperion* _hyperion;
 
@@ -138,7 +189,7 @@ namespace hyperion
 		unsigned _blurRemoveCnt;
 
 		/// The border detection mode
-		QString _detectionMode;
+		DetectionMode _detectionMode;
 
 		/// The black-border detector
 		BlackBorderDetector* _detector;
@@ -191,6 +191,34 @@ public:
 		return false;
 	}
 
+	///
+	/// @brief      Update 'last_use' column entry of a token
+	/// @param[in]  id       The token id
+	/// @param[in]  lastUse  The timestamp of the last use
+	/// @return     true on success else false
+	///
+	inline bool updateTokenUsed(const QString& id, const QString& lastUse)
+	{
+		QVariantMap map;
+		map["last_use"] = lastUse;
+
+		VectorPair cond;
+		cond.append(CPair("id", id));
+		return updateRecord(cond, map);
+	}
+
+	///
+	/// @brief Get all 'token' (hashed) and 'id' column entries of tokens
+	/// @return            A vector of all token entries
+	///
+	inline const QVector<QVariantMap> getTokenHashes()
+	{
+		QVector<QVariantMap> results;
+		getRecords(results, QStringList() << "token" << "id");
+
+		return results;
+	}
+
 	///
 	/// @brief      Create a new token record with comment
 	/// @param[in]  token   The token id as plaintext
@@ -126,6 +126,25 @@ public:
 	///
 	void setReadonlyMode(bool readOnly) { _readonlyMode = readOnly; };
 
+	///
+	/// @brief Start a transaction on the database connection of the calling thread.
+	/// Following writes are committed at once by commitTransaction()
+	/// @return True on success else false
+	///
+	bool startTransaction() const;
+
+	///
+	/// @brief Commit the transaction of the calling thread, rolls back on failure
+	/// @return True on success else false
+	///
+	bool commitTransaction() const;
+
+	///
+	/// @brief Discard the writes of the transaction of the calling thread
+	/// @return True on success else false
+	///
+	bool rollbackTransaction() const;
+
 private:
 
 	Logger* _log;
@@ -138,4 +157,11 @@ private:
 
 	/// addBindValue to query given by QVariantList
 	void doAddBindValue(QSqlQuery& query, const QVariantList& variants) const;
+
+	///
+	/// @brief Get a prepared statement of the calling thread's connection, statements are prepared once and reused
+	/// @param[in]  statement  The SQL statement
+	/// @return                The prepared query, finish() it after reading the results
+	///
+	QSqlQuery prepareQuery(const QString& statement) const;
 };
@@ -0,0 +1,94 @@
+#pragma once
+
+// Qt includes
+#include <QDateTime>
+#include <QList>
+#include <QMargins>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+// Hyperion includes
+#include <utils/ColorRgb.h>
+#include <utils/Image.h>
+
+///
+/// @brief Process wide cache of images decoded by hyperion.getImage().
+/// Effects playing an image or animation (e.g. a GIF) load the same source on every start.
+/// The decoded, cropped and converted frames are kept up to a memory budget, least recently used sources are dropped first.
+/// Only local files (keyed by path and modification time) and embedded image data are cached, images from a URL are always fetched again.
+///
+class AnimationCache
+{
+public:
+	///
+	/// @brief The decoded frames of an image source
+	///
+	struct Animation
+	{
+		QVector<Image<ColorRgb>> frames;
+
+		/// Memory used by the frames in bytes
+		qint64 size = 0;
+	};
+
+	///
+	/// @brief Identifies the source of an animation and the conversion applied to its frames
+	///
+	struct Key
+	{
+		/// File or base64 encoded image data of the effect
+		QString source;
+		/// Modification time of a file, changed files are decoded again
+		QDateTime modified;
+		QMargins crop;
+		bool grayscale = false;
+
+		bool operator==(const Key& other) const;
+
+		/// Same source and conversion, regardless of the modification time
+		bool isSameSource(const Key& other) const;
+	};
+
+	static AnimationCache* getInstance()
+	{
+		static AnimationCache instance;
+		return &instance;
+	}
+
+	AnimationCache(AnimationCache const&) = delete;
+	void operator=(AnimationCache const&) = delete;
+
+	///
+	/// @brief Get the decoded frames of a source
+	/// @param key  The source and conversion
+	/// @return The frames or a null pointer, if the source isn't cached
+	///
+	QSharedPointer<const Animation> find(const Key& key);
+
+	///
+	/// @brief Store the decoded frames of a source.
+	/// Frames exceeding the budget on their own are not cached. Frames still referenced by running effects stay valid when dropped.
+	/// @param key        The source and conversion
+	/// @param animation  The decoded frames
+	///
+	void insert(const Key& key, const QSharedPointer<const Animation>& animation);
+
+private:
+	AnimationCache() = default;
+
+	/// Maximum memory used by cached frames in bytes
+	static const qint64 MEMORY_BUDGET;
+
+	struct Entry
+	{
+		Key key;
+		QSharedPointer<const Animation> animation;
+	};
+
+	QMutex _mutex;
+	/// Entries in order of their last use, most recent first
+	QList<Entry> _entries;
+	qint64 _size = 0;
+};
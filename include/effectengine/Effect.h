@@ -6,10 +6,13 @@
 #include <QSize>
 #include <QImage>
 #include <QPainter>
+#include <QElapsedTimer>
 
 // Hyperion includes
 #include <utils/Components.h>
 #include <utils/Image.h>
+#include <effectengine/EffectClipCache.h>
+#include <hyperion/LedString.h>
 
 #include <atomic>
 
@@ -25,6 +28,7 @@ public:
 	static const int ENDLESS;
 
 	friend class EffectModule;
+	friend class NativeEffect;
 
 	Effect(Hyperion *hyperion
 				, int priority
@@ -71,12 +75,41 @@ public:
 
 	QJsonObject getArgs() const { return _args; }
 
+	///
+	/// @brief Replay a recorded clip of the effect instead of running it. If there is none yet,
+	///        a native effect with a periodic output records one while it runs.
+	///        Has to be called before the effect is started.
+	/// @param key   The effect, its arguments and the LED layout
+	/// @param leds  The LED layout, images are mapped to it for recording
+	///
+	void enableClip(const EffectClip::Key& key, const LedString& leds);
+
+	///
+	/// @brief Set the rate the LED device is written with, hyperion.waitForNextFrame() can align the effect frames to it
+	/// @param rate  The output rate of the smoothing in Hz, 0 if the LEDs are written on each update
+	///
+	void setOutputRate(double rate) { _outputRate = rate; }
+
 signals:
 	void setInput(int priority, const std::vector<ColorRgb> &ledColors, int timeout_ms, bool clearEffect);
 	void setInputImage(int priority, const Image<ColorRgb> &image, int timeout_ms, bool clearEffect);
 
 private:
+	void setEndTime();
 	void setModuleParameters();
+
+	///
+	/// @brief Emit the frames of a clip in a loop until the effect is interrupted
+	/// @param clip  The recorded clip
+	///
+	void playClip(const EffectClip& clip);
+
+	///
+	/// @brief Convert the (premultiplied) effect image to a RGB image in a single pass over the scanlines
+	/// @param qimage  The effect image
+	/// @return The RGB image
+	///
+	static Image<ColorRgb> toRgbImage(const QImage& qimage);
 	void addImage();
 
 	Hyperion *_hyperion;
@@ -95,7 +128,7 @@ private:
 	qint64 _endTime;
 
 	/// Buffer for colorData
-	QVector<ColorRgb> _colors;
+	std::vector<ColorRgb> _colors;
 
 	Logger *_log;
 	// Reflects whenever this effects should interrupt (timeout or external request)
@@ -105,4 +138,14 @@ private:
 	QImage          _image;
 	QPainter       *_painter;
 	QVector<QImage> _imageStack;
+
+	/// Clip replaying or recording the effect
+	bool _clipEnabled;
+	EffectClip::Key _clipKey;
+	LedString _clipLeds;
+
+	/// Frame pacing of hyperion.waitForNextFrame(), deadlines are relative to the monotonic frame timer in nanoseconds
+	double _outputRate;
+	QElapsedTimer _frameTimer;
+	qint64 _frameDue;
 };
@@ -0,0 +1,99 @@
+#pragma once
+
+// Qt includes
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+// Hyperion includes
+#include <utils/ColorRgb.h>
+
+#include <vector>
+
+///
+/// @brief One period of a deterministic effect, recorded as LED colors.
+/// Replaying the clip in a loop is equivalent to running the effect, without rendering and image to LED mapping.
+///
+struct EffectClip
+{
+	///
+	/// @brief Identifies the effect output: the same script and arguments render the same frames on the same LED layout
+	///
+	struct Key
+	{
+		QString script;
+		QJsonObject args;
+		/// Hash of the LED layout the frames were mapped to
+		uint layoutHash = 0;
+		/// Latch time of the LED device, it limits the step time of some effects
+		int latchTime = 0;
+
+		bool operator==(const Key& other) const;
+	};
+
+	/// LED colors of each frame
+	QVector<std::vector<ColorRgb>> frames;
+
+	/// Time until the next frame in microseconds, per frame
+	QVector<qint64> durations;
+
+	/// Memory used by the frames in bytes
+	qint64 size = 0;
+};
+
+///
+/// @brief Process wide cache of recorded effect clips, up to a memory budget.
+/// Least recently used clips are dropped first.
+///
+class EffectClipCache
+{
+public:
+	static EffectClipCache* getInstance()
+	{
+		static EffectClipCache instance;
+		return &instance;
+	}
+
+	EffectClipCache(EffectClipCache const&) = delete;
+	void operator=(EffectClipCache const&) = delete;
+
+	///
+	/// @brief Get the clip recorded for an effect
+	/// @param key  The effect, its arguments and the LED layout
+	/// @return The clip or a null pointer, if the effect wasn't recorded yet
+	///
+	QSharedPointer<const EffectClip> find(const EffectClip::Key& key);
+
+	///
+	/// @brief Store a recorded clip. Clips exceeding the budget on their own are not cached.
+	/// @param key   The effect, its arguments and the LED layout
+	/// @param clip  The recorded clip
+	///
+	void insert(const EffectClip::Key& key, const QSharedPointer<const EffectClip>& clip);
+
+	///
+	/// @brief Check if a clip of the given size fits into the budget at all
+	/// @param size  The size in bytes
+	///
+	static bool fits(qint64 size) { return size <= MEMORY_BUDGET; }
+
+private:
+	EffectClipCache() = default;
+
+	/// Maximum memory used by recorded clips in bytes
+	static const qint64 MEMORY_BUDGET;
+
+	struct Entry
+	{
+		EffectClip::Key key;
+		QSharedPointer<const EffectClip> clip;
+	};
+
+	QMutex _mutex;
+	/// Entries in order of their last use, most recent first
+	QList<Entry> _entries;
+	qint64 _size = 0;
+};
@@ -6,6 +6,8 @@
 #include <effectengine/EffectSchema.h>
 #include <utils/settings.h>
 
+#include <atomic>
+
 class EffectFileHandler : public QObject
 {
 	Q_OBJECT
@@ -41,6 +43,11 @@ public:
 	///
 	QString deleteEffect(const QString& effectName);
 
+	///
+	/// @brief Check if deterministic effects should be recorded and replayed as clips
+	///
+	bool isClipRecordingEnabled() const { return _clipRecording; }
+
 public slots:
 	///
 	/// @brief Handle settings update from Hyperion Settingsmanager emit
@@ -75,6 +82,7 @@ private:
 	QJsonObject _effectConfig;
 	Logger* _log;
 	const QString _rootPath;
+	std::atomic<bool> _clipRecording;
 
 	// available effects
 	std::list<EffectDefinition> _availableEffects;
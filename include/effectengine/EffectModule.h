@@ -6,6 +6,8 @@
 
 #include <QJsonValue>
 
+#include <effectengine/AnimationCache.h>
+
 class Effect;
 
 class EffectModule: public QObject
@@ -31,6 +33,7 @@ public:
 	static PyObject* wrapSetImage              (PyObject *self, PyObject *args);
 	static PyObject* wrapGetImage              (PyObject *self, PyObject *args);
 	static PyObject* wrapAbort                 (PyObject *self, PyObject *args);
+	static PyObject* wrapWaitForNextFrame      (PyObject *self, PyObject *args);
 	static PyObject* wrapImageShow             (PyObject *self, PyObject *args);
 	static PyObject* wrapImageLinearGradient   (PyObject *self, PyObject *args);
 	static PyObject* wrapImageConicalGradient  (PyObject *self, PyObject *args);
@@ -51,4 +54,13 @@ public:
 	static PyObject* wrapImageCOffset          (PyObject *self, PyObject *args);
 	static PyObject* wrapImageCShear           (PyObject *self, PyObject *args);
 	static PyObject* wrapImageResetT           (PyObject *self, PyObject *args);
+
+private:
+	///
+	/// @brief Read and decode all frames of an image source for hyperion.getImage()
+	/// @param key       The source, crop and grayscale conversion
+	/// @param embedded  The source is the base64 encoded image data of the effect
+	/// @return The frames or a null pointer with the Python error set
+	///
+	static QSharedPointer<const AnimationCache::Animation> decodeImage(const AnimationCache::Key& key, bool embedded);
 };
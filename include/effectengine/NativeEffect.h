@@ -0,0 +1,125 @@
+#pragma once
+
+// Qt includes
+#include <QJsonObject>
+#include <QSharedPointer>
+#include <QSize>
+#include <QString>
+
+// Hyperion includes
+#include <utils/ColorRgb.h>
+#include <utils/Image.h>
+
+#include <vector>
+
+class Effect;
+class QPainter;
+struct EffectClip;
+
+namespace hyperion
+{
+	class ImageToLedsMap;
+}
+
+///
+/// @brief Base class of built-in effects implemented in C++.
+/// A native effect replaces the Python script of the same name, it's selected by the script of the effect definition.
+/// It runs in the thread of its Effect without a Python interpreter. Custom scripts are still executed by Python.
+///
+class NativeEffect
+{
+public:
+	virtual ~NativeEffect() = default;
+
+	///
+	/// @brief Create the native implementation of a built-in effect script
+	/// @param script  The script of the effect definition
+	/// @return The native effect or nullptr, if the script needs to be executed by Python
+	///
+	static NativeEffect* create(const QString& script);
+
+	///
+	/// @brief Run the effect until it has finished or is interrupted
+	/// @param effect  The effect which provides the arguments and the output
+	///
+	void run(Effect* effect);
+
+protected:
+	///
+	/// @brief The effect loop, equivalent to the Python script it replaces
+	///
+	virtual void loop() = 0;
+
+	/// @return True if the effect has to stop (timeout or interruption)
+	bool abort() const;
+
+	///
+	/// @brief Sleep for the given time, wakes up early on interruption
+	/// @param seconds  The time to sleep
+	/// @return False if the effect was interrupted meanwhile
+	///
+	bool sleep(double seconds);
+
+	///
+	/// @brief Declare the output of the effect periodic, which allows to record it as a clip for replay.
+	///        Has to be called before the first frame. Each call of setColor(), setColors(), setImage() or imageShow() is a frame.
+	/// @param warmupFrames  Frames until the output repeats
+	/// @param periodFrames  Frames of one period
+	///
+	void setPeriodic(int warmupFrames, int periodFrames);
+
+	/// Set all leds to the given color
+	void setColor(const ColorRgb& color);
+
+	/// Set the color of each led, the size has to match ledCount()
+	void setColors(const std::vector<ColorRgb>& ledColors);
+
+	/// Set an image which will be mapped to the leds
+	void setImage(const Image<ColorRgb>& image);
+
+	/// Scale the effect image to at least the given size, see hyperion.imageMinSize()
+	void imageMinSize(int width, int height);
+
+	/// @return The size of the effect image
+	QSize imageSize() const;
+
+	/// @return The painter of the effect image
+	QPainter* painter() const;
+
+	/// Set the effect image to the leds, see hyperion.imageShow()
+	void imageShow();
+
+	int ledCount() const { return _ledCount; }
+	int latchTime() const { return _latchTime; }
+
+	///
+	/// @brief Get an effect argument, like hyperion.args.get(key, default)
+	///
+	const QJsonObject& args() const;
+	double argDouble(const QString& key, double defaultValue) const;
+	int argInt(const QString& key, int defaultValue) const;
+	bool argBool(const QString& key, bool defaultValue) const;
+	ColorRgb argColor(const QString& key, const ColorRgb& defaultValue) const;
+
+private:
+	///
+	/// @brief Add a frame to the clip being recorded, completes the clip after one period
+	/// @param ledColors  The colors of the frame
+	///
+	void recordFrame(const std::vector<ColorRgb>& ledColors);
+
+	Effect* _effect = nullptr;
+	int _ledCount = 0;
+	int _latchTime = 0;
+
+	/// The clip being recorded, null if the effect isn't recorded
+	QSharedPointer<EffectClip> _clip;
+	/// Maps recorded images to the leds like Hyperion does for effects
+	QSharedPointer<hyperion::ImageToLedsMap> _clipMapping;
+	/// Frames emitted so far and the frames of the recorded period
+	int _frame = 0;
+	int _clipStart = 0;
+	int _clipEnd = 0;
+	/// Time slept since the last frame in microseconds, the recorded timing doesn't include any jitter
+	qint64 _timeSinceFrame = 0;
+};
@@ -17,6 +17,8 @@
 
 #include <flatbuffers/flatbuffers.h>
 
+class QUdpSocket;
+
 const int FLATBUFFER_DEFAULT_PORT = 19400;
 
 namespace hyperionnet
@@ -49,6 +51,14 @@ public:
 	/// @brief Do not read reply messages from Hyperion if set to true
 	void setSkipReply(bool skip);
 
+	///
+	/// @brief Send images and colors over UDP, the priority is still registered and cleared over TCP.
+	/// The UDP transport has to be enabled on the Flatbuffers server. Images too large for the
+	/// datagrams (FlatBufferDatagram::MAX_MESSAGE_SIZE) are sent over TCP.
+	/// @param enable True to use UDP
+	///
+	void setUdpTransport(bool enable);
+
 	///
 	/// @brief Register a new priority with given origin
 	/// @param origin  The user friendly origin string
@@ -81,6 +91,13 @@ public:
 	///
 	void sendMessage(const uint8_t* buffer, uint32_t size);
 
+	///
+	/// @brief Serialize an image request including the message header, to be sent with sendImage()
+	/// @param image The image
+	/// @return The message, it can be shared by several connections
+	///
+	static QByteArray encodeImage(const Image<ColorRgb> &image);
+
 public slots:
 	///
 	/// @brief Set the leds according to the given image
@@ -88,6 +105,13 @@ public slots:
 	///
 	void setImage(const Image<ColorRgb> &image);
 
+	///
+	/// @brief Send an image message created by encodeImage(). While more than the in-flight budget is
+	/// waiting to be sent, the latest frame is held back and replaces the previously held back one.
+	/// @param message The encoded image message
+	///
+	void sendImage(const QByteArray &message);
+
 private slots:
 	///
 	/// @brief Try to connect to the Hyperion host
@@ -99,6 +123,11 @@ private slots:
 	///
 	void readData();
 
+	///
+	/// @brief Slot called when data has been written, sends a held back frame
+	///
+	void writePendingFrame();
+
 signals:
 
 	///
@@ -115,6 +144,20 @@ private:
 	///
 	bool parseReply(const hyperionnet::Reply *reply);
 
+	///
+	/// @brief Log connection state changes and register the priority once connected
+	/// @return True, if messages can be sent
+	///
+	bool isReadyToSend();
+
+	///
+	/// @brief Send a request over UDP, split into datagrams
+	/// @param data  The serialized request, without the size header
+	/// @param size  The size of the request
+	/// @return False, if the request is too large for the UDP transport
+	///
+	bool sendDatagrams(const char* data, int size);
+
 private:
 	/// The TCP-Socket with the connection to the server
 	QTcpSocket _socket;
@@ -138,4 +181,16 @@ private:
 	flatbuffers::FlatBufferBuilder _builder;
 
 	bool _registered;
+
+	/// Latest frame held back while the in-flight budget is exhausted
+	QByteArray _pendingFrame;
+	/// Frames dropped, because the connection did not keep up
+	quint64 _droppedFrames;
+	bool _dropping;
+
+	/// Socket for sending images and colors, if the UDP transport is enabled
+	QUdpSocket* _udpSocket;
+	quint32 _sequence;
+	/// Messages too large for the UDP transport have been reported
+	bool _udpOversized;
 };
@@ -0,0 +1,187 @@
+#pragma once
+
+// Qt includes
+#include <QByteArray>
+#include <QVector>
+
+#include <cstring>
+
+///
+/// @brief Transport of hyperionnet::Request messages over UDP.
+/// A message is split into fragments which fit into a single datagram without IP fragmentation.
+/// Each datagram starts with a header:
+///   'H' 'F' version priority | sequence (32 bit) | fragment index (16 bit) | fragment count (16 bit)
+/// All numbers are big endian. The sequence is incremented per message, the receiver only assembles
+/// the most recent message and drops fragments of older ones.
+///
+namespace FlatBufferDatagram
+{
+	const int HEADER_SIZE = 12;
+	const int MAX_DATAGRAM_SIZE = 1400;
+	const int MAX_PAYLOAD_SIZE = MAX_DATAGRAM_SIZE - HEADER_SIZE;
+	const int MAX_FRAGMENTS = 2048;
+	/// Largest message which can be sent as datagrams, about 2.8 MB
+	const int MAX_MESSAGE_SIZE = MAX_FRAGMENTS * MAX_PAYLOAD_SIZE;
+	const char VERSION = 1;
+
+	///
+	/// @brief Split a message into datagrams
+	/// @param data      The serialized request, without the TCP size header
+	/// @param size      The size of the request
+	/// @param priority  The priority registered for the sender
+	/// @param sequence  The sequence number of the message
+	/// @return The datagrams or an empty list, if the message is too large
+	///
+	inline QVector<QByteArray> fragment(const char* data, int size, quint8 priority, quint32 sequence)
+	{
+		QVector<QByteArray> datagrams;
+		const int count = qMax(1, (size + MAX_PAYLOAD_SIZE - 1) / MAX_PAYLOAD_SIZE);
+		if (count > MAX_FRAGMENTS)
+		{
+			return datagrams;
+		}
+
+		datagrams.reserve(count);
+		for (int index = 0; index < count; ++index)
+		{
+			const int offset = index * MAX_PAYLOAD_SIZE;
+			const int payloadSize = qMin(MAX_PAYLOAD_SIZE, size - offset);
+			const char header[HEADER_SIZE] = {
+				'H', 'F', VERSION, char(priority),
+				char(sequence >> 24), char(sequence >> 16), char(sequence >> 8), char(sequence),
+				char(index >> 8), char(index),
+				char(count >> 8), char(count) };
+
+			QByteArray datagram;
+			datagram.reserve(HEADER_SIZE + payloadSize);
+			datagram.append(header, HEADER_SIZE);
+			datagram.append(data + offset, payloadSize);
+			datagrams.append(datagram);
+		}
+		return datagrams;
+	}
+
+	///
+	/// @brief Check the header of a datagram
+	/// @param datagram The received datagram
+	/// @return True, if the datagram carries a fragment of this protocol version
+	///
+	inline bool isValid(const QByteArray& datagram)
+	{
+		return datagram.size() > HEADER_SIZE && datagram.size() <= MAX_DATAGRAM_SIZE
+			&& datagram[0] == 'H' && datagram[1] == 'F' && datagram[2] == VERSION;
+	}
+
+	/// @return The priority of the sender of a valid datagram
+	inline quint8 priority(const QByteArray& datagram)
+	{
+		return static_cast<quint8>(datagram[3]);
+	}
+
+	///
+	/// @brief Reassembles the most recent message of a single sender
+	///
+	class Reassembler
+	{
+	public:
+		///
+		/// @brief Add a received datagram, stale and duplicate fragments are dropped
+		/// @param datagram A valid datagram
+		/// @return True, if the datagram completed a message, available by message()
+		///
+		bool add(const QByteArray& datagram)
+		{
+			const uchar* header = reinterpret_cast<const uchar*>(datagram.constData());
+			const quint32 sequence = (quint32(header[4]) << 24) | (quint32(header[5]) << 16) | (quint32(header[6]) << 8) | quint32(header[7]);
+			const int index = (header[8] << 8) | header[9];
+			const int count = (header[10] << 8) | header[11];
+			const int payloadSize = datagram.size() - HEADER_SIZE;
+
+			// all but the last fragment are of full size
+			if (count == 0 || count > MAX_FRAGMENTS || index >= count || (index < count - 1 && payloadSize != MAX_PAYLOAD_SIZE))
+			{
+				return false;
+			}
+
+			if (_started)
+			{
+				const qint32 age = static_cast<qint32>(sequence - _sequence);
+				if (age < 0 || (age == 0 && _complete))
+				{
+					++_staleDatagrams;
+					return false;
+				}
+
+				if (age > 0)
+				{
+					if (!_complete)
+					{
+						++_incompleteMessages;
+					}
+					start(sequence, count);
+				}
+				else if (count != _received.size())
+				{
+					return false;
+				}
+			}
+			else
+			{
+				start(sequence, count);
+			}
+
+			if (_received[index])
+			{
+				++_staleDatagrams;
+				return false;
+			}
+
+			memcpy(_buffer.data() + index * MAX_PAYLOAD_SIZE, datagram.constData() + HEADER_SIZE, static_cast<size_t>(payloadSize));
+			_received[index] = true;
+			if (index == count - 1)
+			{
+				_size = index * MAX_PAYLOAD_SIZE + payloadSize;
+			}
+
+			if (++_receivedCount == count)
+			{
+				_complete = true;
+				_buffer.resize(_size);
+				return true;
+			}
+			return false;
+		}
+
+		/// @return The completed message
+		const QByteArray& message() const { return _buffer; }
+
+		/// @return Number of datagrams dropped, because they were duplicates or belonged to an older message
+		quint64 staleDatagrams() const { return _staleDatagrams; }
+
+		/// @return Number of messages dropped, because fragments were lost or a newer message arrived first
+		quint64 incompleteMessages() const { return _incompleteMessages; }
+
+	private:
+		void start(quint32 sequence, int count)
+		{
+			_started = true;
+			_complete = false;
+			_sequence = sequence;
+			_received.fill(false, count);
+			_receivedCount = 0;
+			_buffer.resize(count * MAX_PAYLOAD_SIZE);
+			_size = 0;
+		}
+
+		bool _started = false;
+		bool _complete = false;
+		quint32 _sequence = 0;
+		QVector<bool> _received;
+		int _receivedCount = 0;
+		QByteArray _buffer;
+		int _size = 0;
+
+		quint64 _staleDatagrams = 0;
+		quint64 _incompleteMessages = 0;
+	};
+}
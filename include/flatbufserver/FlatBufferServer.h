@@ -5,10 +5,15 @@
 #include <utils/settings.h>
 
 // qt
+#include <QHash>
 #include <QVector>
 
+#include <flatbufserver/FlatBufferDatagram.h>
+
 class BonjourServiceRegister;
 class QTcpServer;
+class QUdpSocket;
+class QHostAddress;
 class FlatBufferClient;
 class NetOrigin;
 
@@ -16,6 +21,7 @@ class NetOrigin;
 ///
 /// @brief A TcpServer to receive images of different formats with Google Flatbuffer
 /// Images will be forwarded to all Hyperion instances
+/// Optionally images and colors are received over UDP on the same port, from clients registered over TCP
 ///
 class FlatBufferServer : public QObject
 {
@@ -45,6 +51,11 @@ private slots:
 	///
 	void clientDisconnected();
 
+	///
+	/// @brief Is called whenever datagrams have been received
+	///
+	void readPendingDatagrams();
+
 private:
 	///
 	/// @brief Start the server with current _port
@@ -56,15 +67,27 @@ private:
 	///
 	void stopServer();
 
+	///
+	/// @brief Find the client registered over TCP, which is sending datagrams
+	/// @param address   The sender's address
+	/// @param priority  The sender's priority
+	/// @return The client or nullptr
+	///
+	FlatBufferClient* findClient(const QHostAddress& address, int priority) const;
 
 private:
 	QTcpServer* _server;
+	QUdpSocket* _udpServer;
 	NetOrigin* _netOrigin;
 	Logger* _log;
 	int _timeout;
 	quint16 _port;
+	bool _udpEnabled;
 	const QJsonDocument _config;
 	BonjourServiceRegister * _serviceRegister = nullptr;
 
 	QVector<FlatBufferClient*> _openConnections;
+
+	/// Messages received over UDP per client
+	QHash<FlatBufferClient*, FlatBufferDatagram::Reassembler> _reassemblers;
 };
@@ -0,0 +1,98 @@
+#pragma once
+
+// Qt includes
+#include <QHostAddress>
+#include <QJsonObject>
+#include <QList>
+#include <QTcpSocket>
+#include <QTimer>
+
+// Utils includes
+#include <utils/Logger.h>
+
+///
+/// @brief Persistent connection to a JSON forwarding target.
+/// Messages are queued and written asynchronously, replies are discarded. While the target is unreachable
+/// the connection is retried with increasing delays and only the latest state per priority is kept.
+///
+class JsonForwardConnection : public QObject
+{
+	Q_OBJECT
+
+public:
+	///
+	/// @brief Constructor, starts connecting to the target
+	/// @param host   The target host
+	/// @param port   The port of the target's JSON server
+	/// @param parent The parent object
+	///
+	JsonForwardConnection(const QHostAddress& host, quint16 port, QObject* parent = nullptr);
+
+	~JsonForwardConnection() override;
+
+	///
+	/// @brief Queue a message for the target, it replaces queued messages it supersedes.
+	/// The call does not block, the message is written when the target is connected and accepts data.
+	/// @param message The JSON message
+	///
+	void sendMessage(const QJsonObject& message);
+
+	/// @return True, if connected to the target
+	bool isConnected() const { return _socket.state() == QAbstractSocket::ConnectedState; }
+
+	/// @return Number of queued messages not written yet
+	int pendingMessages() const { return _queue.size(); }
+
+	/// @return Number of queued messages replaced by a newer message for the same priority
+	quint64 supersededMessages() const { return _superseded; }
+
+	/// @return Number of messages dropped because the queue was full
+	quint64 droppedMessages() const { return _dropped; }
+
+private slots:
+	void connectToHost();
+	void onConnected();
+	void onConnectTimeout();
+	void onStateChanged(QAbstractSocket::SocketState state);
+	void readReply();
+
+	///
+	/// @brief Write queued messages as long as the socket buffer is not exhausted
+	///
+	void writePending();
+
+private:
+	///
+	/// @brief Schedule the next connection attempt, doubling the delay up to a maximum
+	///
+	void scheduleReconnect();
+
+	///
+	/// @brief Get the state a message sets on the target, a later message with the same key supersedes it
+	/// @param message The JSON message
+	/// @return The key or an empty string, if the message can't be superseded
+	///
+	static QString supersedeKey(const QJsonObject& message);
+
+	struct Message
+	{
+		QString key;
+		QByteArray data;
+	};
+
+	Logger* _log;
+
+	QHostAddress _host;
+	quint16 _port;
+
+	QTcpSocket _socket;
+	QTimer _connectTimer;
+	QTimer _reconnectTimer;
+	int _reconnectDelay;
+
+	/// Messages not written yet, in order
+	QList<Message> _queue;
+
+	quint64 _superseded;
+	quint64 _dropped;
+};
@@ -26,8 +26,8 @@
 
 // Forward declaration
 class Hyperion;
-class QTcpSocket;
 class FlatBufferConnection;
+class JsonForwardConnection;
 
 class MessageForwarder : public QObject
 {
@@ -61,7 +61,7 @@ private slots:
 	void handlePriorityChanges(quint8 priority);
 
 	///
-	/// @brief Forward message to all json target hosts
+	/// @brief Forward message to all json target hosts, the message is queued per target and sent asynchronously
 	/// @param message The JSON message to send
 	///
 	void forwardJsonMessage(const QJsonObject &message);
@@ -72,13 +72,6 @@ private slots:
 	///
 	void forwardFlatbufferMessage(const QString& name, const Image<ColorRgb> &image);
 
-	///
-	/// @brief Forward message to a single json target host
-	/// @param message The JSON message to send
-	/// @param socket The TCP-Socket with the connection to the target host
-	///
-	void sendJsonMessage(const QJsonObject &message, QTcpSocket *socket);
-
 private:
 
 	struct TargetHost {
@@ -102,6 +95,7 @@ private:
 
 	// JSON connections for forwarding
 	QList<TargetHost> _jsonTargets;
+	QList<JsonForwardConnection*> _jsonClients;
 
 	/// Flatbuffer connection for forwarding
 	QList<TargetHost> _flatbufferTargets;
@@ -24,7 +24,8 @@ public:
 	///
 	/// Captures a single snapshot of the display and writes the data to the given image. The
 	/// provided image should have the same dimensions as the configured values (_width and
-	/// _height)
+	/// _height). The device stays open and mapped between frames, it is mapped again on a
+	/// change of the screen mode.
 	///
 	/// @param[out] image  The snapped screenshot (should be initialized with correct width and
 	/// height)
@@ -56,12 +57,42 @@ public:
 	///
 	QJsonObject discover(const QJsonObject& params);
 
+protected:
+	///
+	/// @brief Query the fixed screen information of the opened device
+	/// @param[in]  fd       The device's file descriptor
+	/// @param[out] fixInfo  The fixed screen information
+	/// @return True on success
+	///
+	virtual bool queryFixInfo(int fd, struct fb_fix_screeninfo & fixInfo) const;
+
+	///
+	/// @brief Query the variable screen information (resolution and pixel layout) of the opened device
+	/// @param[in]  fd       The device's file descriptor
+	/// @param[out] varInfo  The variable screen information
+	/// @return True on success
+	///
+	virtual bool queryVarInfo(int fd, struct fb_var_screeninfo & varInfo) const;
+
 private:
 
 	bool openDevice();
 	bool closeDevice();
 	bool getScreenInfo();
 
+	///
+	/// @brief Map the framebuffer memory of the opened device, replaces a previous mapping
+	/// @return True on success
+	///
+	bool mapDevice();
+	void unmapDevice();
+
+	///
+	/// @brief Check the screen mode before grabbing, the device is mapped again if the mode has changed
+	/// @return True, if the mapping can be grabbed
+	///
+	bool checkScreenMode();
+
 	/// Framebuffer device e.g. /dev/fb0
 	QString _fbDevice;
 
@@ -70,4 +101,8 @@ private:
 	struct fb_fix_screeninfo _fixInfo;
 
 	PixelFormat _pixelFormat;
+
+	/// Framebuffer memory, mapped while the device is open
+	uint8_t * _fbp;
+	size_t _fbpSize;
 };
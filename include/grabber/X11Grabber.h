@@ -19,6 +19,7 @@
 #include <X11/extensions/Xrandr.h>
 #include <X11/extensions/Xrender.h>
 #include <X11/extensions/XShm.h>
+#include <X11/extensions/Xdamage.h>
 #include <sys/ipc.h>
 #include <sys/shm.h>
 
@@ -69,6 +70,12 @@ public:
 	///
 	void setCropping(int cropLeft, int cropRight, int cropTop, int cropBottom) override;
 
+	///
+	/// @brief Grab only when XDamage reported screen changes since the last grab
+	/// @param  enable  True to skip grabs of an unchanged screen
+	///
+	void setDamageTracking(bool enable) override;
+
 	///
 	/// @brief Discover X11 screens available (for configuration).
 	///
@@ -90,6 +97,12 @@ private:
 	void freeResources();
 	void setupResources();
 
+	///
+	/// @brief Process pending XDamage events and acknowledge the damage
+	/// @return True, if the screen changed since the last call
+	///
+	bool isScreenDamaged();
+
 	/// Reference to the X11 display (nullptr if not opened)
 	Display* _x11Display;
 	Window _window;
@@ -107,6 +120,9 @@ private:
 
 	int _XRandREventBase;
 
+	Damage _damage;
+	int _XDamageEventBase;
+
 	XTransform _transform;
 
 	unsigned _calculatedWidth;
@@ -118,8 +134,12 @@ private:
 	bool _XShmPixmapAvailable;
 	bool _XRenderAvailable;
 	bool _XRandRAvailable;
+	bool _XDamageAvailable;
 	bool _isWayland;
 
+	bool _damageTracking;
+	bool _isDamaged;
+
 	Logger * _logger;
 
 	Image<ColorRgb> _image;
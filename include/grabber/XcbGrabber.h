@@ -13,6 +13,7 @@
 #include <sys/ipc.h>
 #include <sys/shm.h>
 
+#include <xcb/damage.h>
 #include <xcb/randr.h>
 #include <xcb/shm.h>
 #include <xcb/xcb.h>
@@ -38,6 +39,8 @@ public:
 	bool setWidthHeight(int width, int height) override { return true; }
 	bool setPixelDecimation(int pixelDecimation) override;
 	void setCropping(int cropLeft, int cropRight, int cropTop, int cropBottom) override;
+	void setDamageTracking(bool enable) override;
+	void setAsyncCapture(bool enable) override;
 
 	///
 	/// @brief Discover XCB screens available (for configuration).
@@ -59,18 +62,40 @@ private:
 	void setupRender();
 	void setupRandr();
 	void setupShm();
+	void setupDamage();
+	bool isScreenDamaged();
+
+	///
+	/// @brief Issue the composite and shm image requests for a frame without waiting for the reply
+	/// @param buffer  The capture buffer to render the frame into
+	/// @return The cookie of the pending image request
+	///
+	xcb_shm_get_image_cookie_t requestFrame(int buffer);
+
+	///
+	/// @brief Deliver the frame in flight and optionally request the next one into the other buffer
+	/// @param[out] image  The captured image
+	/// @param requestNext  Request the next frame before the current one is resampled
+	/// @return 0 on success, -1 on error
+	///
+	int grabFramePipelined(Image<ColorRgb> & image, bool requestNext);
+
+	/// Number of capture buffers used with asynchronous capture
+	static constexpr int CAPTURE_BUFFERS = 2;
+
 	xcb_screen_t * getScreen(const xcb_setup_t *setup, int screen_num) const;
 	xcb_render_pictformat_t findFormatForVisual(xcb_visualid_t visual) const;
 
 	xcb_connection_t * _connection;
 	xcb_screen_t * _screen;
-	xcb_pixmap_t _pixmap;
+	xcb_pixmap_t _pixmap[CAPTURE_BUFFERS];
 	xcb_render_pictformat_t _srcFormat;
 	xcb_render_pictformat_t _dstFormat;
 	xcb_render_picture_t _srcPicture;
-	xcb_render_picture_t _dstPicture;
+	xcb_render_picture_t _dstPicture[CAPTURE_BUFFERS];
 	xcb_render_transform_t _transform;
-	xcb_shm_seg_t  _shminfo;
+	xcb_shm_seg_t  _shminfo[CAPTURE_BUFFERS];
+	xcb_damage_damage_t _damage;
 
 	int _screen_num;
 	unsigned _screenWidth;
@@ -82,11 +107,22 @@ private:
 	bool _XcbRandRAvailable;
 	bool _XcbShmAvailable;
 	bool _XcbShmPixmapAvailable;
+	bool _XcbDamageAvailable;
 	bool _isWayland;
 
+	bool _damageTracking;
+	bool _isDamaged;
+
 	Logger * _logger;
 
-	uint8_t * _shmData;
+	int _shmId[CAPTURE_BUFFERS];
+	uint8_t * _shmData[CAPTURE_BUFFERS];
+
+	int _bufferCount;
+	bool _asyncCapture;
+	int _pendingBuffer;
+	xcb_shm_get_image_cookie_t _pendingCookie;
 
 	int _XcbRandREventBase;
+	int _XcbDamageEventBase;
 };
@@ -4,6 +4,7 @@
 #include <utils/settings.h>
 
 //qt
+#include <QHash>
 #include <QMap>
 #include <QVector>
 
@@ -24,6 +25,11 @@ private:
 	AuthManager(QObject *parent = nullptr, bool readonlyMode = false);
 
 public:
+	///
+	/// @brief Writes pending token usage timestamps to the database
+	///
+	~AuthManager() override;
+
 	struct AuthDefinition
 	{
 		QString id;
@@ -218,6 +224,11 @@ private:
 	///
 	void setAuthBlock(bool user = false);
 
+	///
+	/// @brief Rebuild the in-memory token index from the database
+	///
+	void loadTokenIndex();
+
 	/// Database interface for auth table
 	AuthTable *_authTable;
 
@@ -251,6 +262,15 @@ private:
 	// Contains timestamps of failed token login attempts
 	QVector<uint64_t> _tokenAuthAttempts;
 
+	/// Token ids by token hash, token authorization is answered from memory
+	QHash<QByteArray, QString> _tokenIndex;
+
+	/// Last use of tokens by id, not written to the database yet
+	QHash<QString, QString> _tokenLastUse;
+
+	/// Writes the last use of tokens periodically
+	QTimer *_lastUseTimer;
+
 private slots:
 	///
 	/// @brief Check timeout of pending requests
@@ -261,4 +281,9 @@ private slots:
 	/// @brief Check if there are timeouts for failed login attempts
 	///
 	void checkAuthBlockTimeout();
+
+	///
+	/// @brief Write the last use of tokens to the database in a single transaction
+	///
+	void writeTokenLastUse();
 };
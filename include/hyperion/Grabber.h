@@ -78,6 +78,16 @@ public:
 	///
 	virtual bool setDisplayIndex(int /*index*/) { return true; }
 
+	///
+	/// @brief Capture only when the screen content changed since the last grab (used from x11/xcb)
+	///
+	virtual void setDamageTracking(bool /*enable*/) {}
+
+	///
+	/// @brief Pipeline the capture of the next frame while the current one is processed (used from xcb)
+	///
+	virtual void setAsyncCapture(bool /*enable*/) {}
+
 	///
 	/// @brief Prevent the real capture implementation from capturing if disabled
 	///
@@ -6,9 +6,11 @@
 #include <QString>
 #include <QStringList>
 #include <QMultiMap>
+#include <QElapsedTimer>
 
 #include <utils/Logger.h>
 #include <utils/Components.h>
+#include <utils/Metrics.h>
 #include <utils/Image.h>
 #include <utils/ColorRgb.h>
 #include <utils/VideoMode.h>
@@ -40,6 +42,7 @@ public:
 	static const int DEFAULT_MIN_GRAB_RATE_HZ;
 	static const int DEFAULT_MAX_GRAB_RATE_HZ;
 	static const int DEFAULT_PIXELDECIMATION;
+	static const int UNCHANGED_FRAME_REFRESH_MS;
 
 	static QMap<int, QString> GRABBER_SYS_CLIENTS;
 	static QMap<int, QString> GRABBER_V4L_CLIENTS;
@@ -92,13 +95,21 @@ public:
 			_image.resize(w, h);
 		}
 
-		int ret = grabber.grabFrame(_image);
-		if (ret >= 0)
+		int ret;
 		{
+			Metrics::ScopedTimer timer(Metrics::GRAB);
+			ret = grabber.grabFrame(_image);
+		}
+
+		// a positive return value signals an unchanged frame, which is only pushed again
+		// from time to time to keep the capture source alive
+		if (ret == 0 || (ret > 0 && _lastFramePushed.hasExpired(UNCHANGED_FRAME_REFRESH_MS)))
+		{
+			_lastFramePushed.start();
 			emit systemImage(_grabberName, _image);
 			return true;
 		}
-		return false;
+		return ret > 0;
 	}
 
 public slots:
@@ -184,4 +195,7 @@ protected:
 
 	/// The image used for grabbing frames
 	Image<ColorRgb> _image;
+
+	/// Time since the last frame was pushed
+	QElapsedTimer _lastFramePushed;
 };
@@ -88,6 +88,11 @@ public:
 	///
 	QSize getLedGridSize() const { return _ledGridSize; }
 
+	///
+	/// @brief Return the led layout
+	///
+	const LedString& getLedString() const { return _ledString; }
+
 	/// gets the methode how image is maped to leds
 	int getLedMappingType() const;
 
@@ -497,6 +502,8 @@ private slots:
 private:
 	friend class HyperionDaemon;
 	friend class HyperionIManager;
+	/// runs an instance without the daemon in tests, see test/HyperionTestInstance.h
+	friend class HyperionTestInstance;
 
 	///
 	/// @brief Constructs the Hyperion instance, just accessible for HyperionIManager
@@ -519,8 +526,6 @@ private:
 	/// Image Processor
 	ImageProcessor* _imageProcessor;
 
-	std::vector<ColorOrder> _ledStringColorOrder;
-
 	/// The priority muxer
 	PriorityMuxer* _muxer;
 
@@ -557,6 +562,10 @@ private:
 	/// buffer for leds (with adjustment)
 	std::vector<ColorRgb> _ledBuffer;
 
+	/// Fingerprint of the last image of the visible priority written to the device, valid until any other update
+	quint64 _imageFingerprint;
+	bool _imageFingerprintValid;
+
 	VideoMode _currVideoMode = VideoMode::VIDEO_2D;
 
 #if defined(ENABLE_BOBLIGHT_SERVER)
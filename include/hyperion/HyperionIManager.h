@@ -189,6 +189,11 @@ private:
 	///
 	bool isInstAllowed(quint8 inst) const { return (inst > 0); }
 
+	///
+	/// @brief Share the analysis of captured frames (e.g. black border detection) across instances when more than one instance is running
+	///
+	void updateSharedProcessing();
+
 private:
 	Logger* _log;
 	InstanceTable* _instanceTable;
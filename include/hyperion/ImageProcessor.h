@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QString>
+#include <QList>
+#include <QSharedPointer>
 
 // Utils includes
 #include <utils/Image.h>
@@ -56,6 +58,12 @@ public:
 	/// Returns state of black border detector
 	bool blackBorderDetectorEnabled() const;
 
+	///
+	/// @brief Check whether processing the last image again would give the same LED colors
+	/// @return False while the black border detection awaits further frames or a mapping is built in the background
+	///
+	bool isSettled() const;
+
 	/// Returns the current _userMappingType, this may not be the current applied type!
 	int getUserLedMappingType() const { return _userMappingType; }
 
@@ -183,30 +191,27 @@ private:
 	template <typename Pixel_T>
 	void verifyBorder(const Image<Pixel_T> & image)
 	{
-		if (!_borderProcessor->enabled() && ( _imageToLeds->horizontalBorder()!=0 || _imageToLeds->verticalBorder()!=0 ))
+		// switch to a mapping which has been built in the background meanwhile
+		takePendingMapping();
+
+		if (!_borderProcessor->enabled() && ( _requestedHorizontalBorder!=0 || _requestedVerticalBorder!=0 ))
 		{
 			Debug(_log, "Reset border");
 			_borderProcessor->process(image);
-			delete _imageToLeds;
-			_imageToLeds = new hyperion::ImageToLedsMap(image.width(), image.height(), 0, 0, _ledString.leds());
+			requestMapping(image.width(), image.height(), 0, 0);
 		}
 
 		if(_borderProcessor->enabled() && _borderProcessor->process(image))
 		{
 			const hyperion::BlackBorder border = _borderProcessor->getCurrentBorder();
 
-			// Clean up the old mapping
-			delete _imageToLeds;
-
 			if (border.unknown)
 			{
-				// Construct a new buffer and mapping
-				_imageToLeds = new hyperion::ImageToLedsMap(image.width(), image.height(), 0, 0, _ledString.leds());
+				requestMapping(image.width(), image.height(), 0, 0);
 			}
 			else
 			{
-				// Construct a new buffer and mapping
-				_imageToLeds = new hyperion::ImageToLedsMap(image.width(), image.height(), border.horizontalSize, border.verticalSize, _ledString.leds());
+				requestMapping(image.width(), image.height(), border.horizontalSize, border.verticalSize);
 			}
 
 			//Debug(Logger::getInstance("BLACKBORDER"),  "CURRENT BORDER TYPE: unknown=%d hor.size=%d vert.size=%d",
@@ -214,6 +219,46 @@ private:
 		}
 	}
 
+	///
+	/// Get a mapping for the given geometry from the cache and mark it as most recently used
+	///
+	/// @param[in] width            The width of the image
+	/// @param[in] height           The height of the image
+	/// @param[in] horizontalBorder The size of the horizontal border
+	/// @param[in] verticalBorder   The size of the vertical border
+	///
+	/// @return The mapping or a null pointer, if not cached
+	///
+	QSharedPointer<hyperion::ImageToLedsMap> findMapping(unsigned width, unsigned height, unsigned horizontalBorder, unsigned verticalBorder);
+
+	///
+	/// Request a mapping with other borders for the current image size. A cached mapping is applied immediately,
+	/// a new one is built in the background while the current mapping is kept in use.
+	///
+	/// @param[in] width            The width of the image
+	/// @param[in] height           The height of the image
+	/// @param[in] horizontalBorder The size of the horizontal border
+	/// @param[in] verticalBorder   The size of the vertical border
+	///
+	void requestMapping(unsigned width, unsigned height, unsigned horizontalBorder, unsigned verticalBorder);
+
+	///
+	/// Apply the mapping built in the background, if finished and still requested
+	///
+	void takePendingMapping();
+
+	///
+	/// Add a mapping to the cache, dropping the least recently used ones
+	///
+	/// @param[in] map The mapping to add
+	///
+	void cacheMapping(const QSharedPointer<hyperion::ImageToLedsMap>& map);
+
+	///
+	/// Drop all cached mappings and a pending build (eg on led layout change)
+	///
+	void clearMappings();
+
 private slots:
 	void handleSettingsUpdate(settings::type type, const QJsonDocument& config);
 
@@ -226,7 +271,18 @@ private:
 	hyperion::BlackBorderProcessor * _borderProcessor;
 
 	/// The mapping of image-pixels to LEDs
-	hyperion::ImageToLedsMap* _imageToLeds;
+	QSharedPointer<hyperion::ImageToLedsMap> _imageToLeds;
+
+	/// Recently used mappings, most recent first
+	QList<QSharedPointer<hyperion::ImageToLedsMap>> _mappingCache;
+
+	/// Mapping which is built in the background
+	struct PendingMapping;
+	QSharedPointer<PendingMapping> _pendingMapping;
+
+	/// The borders of the last requested mapping
+	unsigned _requestedHorizontalBorder;
+	unsigned _requestedVerticalBorder;
 
 	/// Type of image 2 led mapping
 	int _mappingType;
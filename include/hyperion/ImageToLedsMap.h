@@ -24,8 +24,8 @@ namespace hyperion
 	public:
 
 		///
-		/// Constructs an mapping from the absolute indices in an image to each led based on the border
-		/// definition given in the list of leds. The map holds absolute indices to any given image,
+		/// Constructs an mapping from the regions in an image to each led based on the border
+		/// definition given in the list of leds. The map holds pixel aligned regions of any given image,
 		/// provided that it is row-oriented.
 		/// The mapping is created purely on size (width and height). The given borders are excluded
 		/// from indexing.
@@ -34,14 +34,14 @@ namespace hyperion
 		/// @param[in] height           The width of the indexed image
 		/// @param[in] horizontalBorder The size of the horizontal border (0=no border)
 		/// @param[in] verticalBorder   The size of the vertical border (0=no border)
-		/// @param[in] leds             The list with led specifications
+		/// @param[in] leds             The led specifications
 		///
 		ImageToLedsMap(
 				const unsigned width,
 				const unsigned height,
 				const unsigned horizontalBorder,
 				const unsigned verticalBorder,
-				const std::vector<Led> & leds);
+				const LedString & leds);
 
 		///
 		/// Returns the width of the indexed image
@@ -71,7 +71,7 @@ namespace hyperion
 		template <typename Pixel_T>
 		std::vector<ColorRgb> getMeanLedColor(const Image<Pixel_T> & image) const
 		{
-			std::vector<ColorRgb> colors(_colorsMap.size(), ColorRgb{0,0,0});
+			std::vector<ColorRgb> colors(_bounds.size(), ColorRgb{0,0,0});
 			getMeanLedColor(image, colors);
 			return colors;
 		}
@@ -87,18 +87,18 @@ namespace hyperion
 		void getMeanLedColor(const Image<Pixel_T> & image, std::vector<ColorRgb> & ledColors) const
 		{
 			// Sanity check for the number of leds
-			//assert(_colorsMap.size() == ledColors.size());
-			if(_colorsMap.size() != ledColors.size())
+			//assert(_bounds.size() == ledColors.size());
+			if(_bounds.size() != ledColors.size())
 			{
-				Debug(Logger::getInstance("HYPERION"), "ImageToLedsMap: colorsMap.size != ledColors.size -> %d != %d", _colorsMap.size(), ledColors.size());
+				Debug(Logger::getInstance("HYPERION"), "ImageToLedsMap: colorsMap.size != ledColors.size -> %d != %d", _bounds.size(), ledColors.size());
 				return;
 			}
 
 			// Iterate each led and compute the mean
 			auto led = ledColors.begin();
-			for (auto colors = _colorsMap.begin(); colors != _colorsMap.end(); ++colors, ++led)
+			for (auto bounds = _bounds.begin(); bounds != _bounds.end(); ++bounds, ++led)
 			{
-				const ColorRgb color = calcMeanColor(image, *colors);
+				const ColorRgb color = calcMeanColor(image, *bounds);
 				*led = color;
 			}
 		}
@@ -114,7 +114,7 @@ namespace hyperion
 		template <typename Pixel_T>
 		std::vector<ColorRgb> getUniLedColor(const Image<Pixel_T> & image) const
 		{
-			std::vector<ColorRgb> colors(_colorsMap.size(), ColorRgb{0,0,0});
+			std::vector<ColorRgb> colors(_bounds.size(), ColorRgb{0,0,0});
 			getUniLedColor(image, colors);
 			return colors;
 		}
@@ -130,10 +130,10 @@ namespace hyperion
 		void getUniLedColor(const Image<Pixel_T> & image, std::vector<ColorRgb> & ledColors) const
 		{
 			// Sanity check for the number of leds
-			// assert(_colorsMap.size() == ledColors.size());
-			if(_colorsMap.size() != ledColors.size())
+			// assert(_bounds.size() == ledColors.size());
+			if(_bounds.size() != ledColors.size())
 			{
-				Debug(Logger::getInstance("HYPERION"), "ImageToLedsMap: colorsMap.size != ledColors.size -> %d != %d", _colorsMap.size(), ledColors.size());
+				Debug(Logger::getInstance("HYPERION"), "ImageToLedsMap: colorsMap.size != ledColors.size -> %d != %d", _bounds.size(), ledColors.size());
 				return;
 			}
 
@@ -153,22 +153,22 @@ namespace hyperion
 
 		const unsigned _verticalBorder;
 
-		/// The absolute indices into the image for each led
-		std::vector<std::vector<int32_t>> _colorsMap;
+		/// The pixel aligned region in the image for each led
+		std::vector<LedString::PixelBounds> _bounds;
 
 		///
-		/// Calculates the 'mean color' of the given list. This is the mean over each color-channel
+		/// Calculates the 'mean color' of the given region. This is the mean over each color-channel
 		/// (red, green, blue)
 		///
 		/// @param[in] image The image a section from which an average color must be computed
-		/// @param[in] colors  The list with colors
+		/// @param[in] bounds  The region of the image
 		///
-		/// @return The mean of the given list of colors (or black when empty)
+		/// @return The mean of the colors in the region (or black when empty)
 		///
 		template <typename Pixel_T>
-		ColorRgb calcMeanColor(const Image<Pixel_T> & image, const std::vector<int32_t> & colors) const
+		ColorRgb calcMeanColor(const Image<Pixel_T> & image, const LedString::PixelBounds & bounds) const
 		{
-			const auto colorVecSize = colors.size();
+			const unsigned colorVecSize = unsigned(bounds.maxX - bounds.minX) * unsigned(bounds.maxY - bounds.minY);
 
 			if (colorVecSize == 0)
 			{
@@ -181,12 +181,17 @@ namespace hyperion
 			uint_fast32_t cummBlue  = 0;
 			const auto& imgData = image.memptr();
 
-			for (const unsigned colorOffset : colors)
+			// walk the region row by row
+			for (unsigned y = bounds.minY; y < bounds.maxY; ++y)
 			{
-				const auto& pixel = imgData[colorOffset];
-				cummRed   += pixel.red;
-				cummGreen += pixel.green;
-				cummBlue  += pixel.blue;
+				const auto* row = imgData + y * _width;
+				for (unsigned x = bounds.minX; x < bounds.maxX; ++x)
+				{
+					const auto& pixel = row[x];
+					cummRed   += pixel.red;
+					cummGreen += pixel.green;
+					cummBlue  += pixel.blue;
+				}
 			}
 
 			// Compute the average of each color channel
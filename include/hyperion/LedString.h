@@ -2,6 +2,7 @@
 #pragma once
 
 // STL includes
+#include <cstdint>
 #include <ctime>
 #include <vector>
 
@@ -102,26 +103,83 @@ struct Led
 };
 
 ///
-/// The LedString contains the image integration information of the leds
+/// The LedString contains the image integration information of the leds.
+/// The regions are stored as structure of arrays in fixed-point, per frame consumers only walk the lanes they need.
 ///
 class LedString
 {
 public:
+	/// Fixed-point representation of the fraction 1.0 of the region bounds
+	static const uint32_t FRACTION_ONE = 0xFFFF;
+
+	///
+	/// The region of a led aligned to the pixels of an image, the maximums are exclusive.
+	/// Leds without area have an empty region.
+	///
+	struct PixelBounds
+	{
+		uint16_t minX;
+		uint16_t maxX;
+		uint16_t minY;
+		uint16_t maxY;
+	};
+
+	///
+	/// Appends a led to the string
+	///
+	/// @param led The led specification
+	///
+	void append(const Led& led);
+
+	///
+	/// Returns the number of leds
+	///
+	/// @return The number of leds
 	///
-	/// Returns the led specifications
+	size_t size() const { return _colorOrders.size(); }
+
+	///
+	/// Returns the specification of a single led
 	///
-	/// @return The list with led specifications
+	/// @param index The index of the led
+	/// @return The led specification, the fractions are rounded to the fixed-point precision
 	///
-	std::vector<Led>& leds();
+	Led led(size_t index) const;
 
 	///
-	/// Returns the led specifications
+	/// Returns the color order lane
+	///
+	/// @return The color order per led
 	///
-	/// @return The list with led specifications
+	const std::vector<ColorOrder>& colorOrders() const { return _colorOrders; }
+
+	///
+	/// Returns, if all leds use the RGB color order and no reordering is required
 	///
-	const std::vector<Led>& leds() const;
+	bool isRgbOrder() const { return _rgbOrder; }
+
+	///
+	/// Computes the pixel aligned regions of all leds for an image geometry.
+	/// Each region covers at least a single pixel, unless the led has no area.
+	///
+	/// @param[in] width            The width of the image
+	/// @param[in] height           The height of the image
+	/// @param[in] horizontalBorder The size of the horizontal border (0=no border)
+	/// @param[in] verticalBorder   The size of the vertical border (0=no border)
+	/// @return The region per led
+	///
+	std::vector<PixelBounds> pixelBounds(unsigned width, unsigned height, unsigned horizontalBorder, unsigned verticalBorder) const;
 
 private:
-	/// The list with led specifications
-	std::vector<Led> mLeds;
+	/// The region bounds per led in fixed-point
+	std::vector<uint16_t> _minX;
+	std::vector<uint16_t> _maxX;
+	std::vector<uint16_t> _minY;
+	std::vector<uint16_t> _maxY;
+
+	/// The color order per led
+	std::vector<ColorOrder> _colorOrders;
+
+	/// True, if all leds use the RGB color order
+	bool _rgbOrder = true;
 };
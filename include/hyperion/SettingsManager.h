@@ -8,6 +8,8 @@ using namespace semver;
 
 // qt includes
 #include <QJsonObject>
+#include <QHash>
+#include <QMap>
 
 const int GLOABL_INSTANCE_ID = 255;
 
@@ -66,6 +68,27 @@ signals:
 	void settingsChanged(settings::type type, const QJsonDocument& data);
 
 private:
+	///
+	/// @brief Write changed settings to the database in a single transaction, rolled back if a write fails
+	/// @param changes  The changed settings by type
+	/// @return True on success else false
+	///
+	bool writeSettings(const QMap<QString, QJsonDocument>& changes);
+
+	///
+	/// @brief Get a setting from the in-memory store, it is read from the database on first access only
+	/// @param key  The settings type as string
+	/// @return The parsed setting
+	///
+	QJsonDocument cachedSetting(const QString& key) const;
+
+	///
+	/// @brief Update a setting in the in-memory store, global settings are updated for all instances
+	/// @param key  The settings type as string
+	/// @param doc  The parsed setting
+	///
+	void storeSetting(const QString& key, const QJsonDocument& doc) const;
+
 	///
 	/// @brief Add possible migrations steps for configuration here
 	/// @param config The configuration object
@@ -94,6 +117,9 @@ private:
 	/// the current configuration of this instance
 	QJsonObject _qconfig;
 
+	/// Parsed settings of this instance, the authoritative copy of the database. Global settings are shared by all instances
+	mutable QHash<QString, QJsonDocument> _settings;
+
 	semver::version _configVersion;
 	semver::version _previousVersion;
 
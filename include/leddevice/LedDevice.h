@@ -159,6 +159,13 @@ public:
 	///
 	void setLogger(Logger* log) { _log = log; }
 
+	///
+	/// @brief Set the index of the instance the device belongs to, used to count its writes.
+	///
+	/// @param[in] instance The instance index
+	///
+	void setInstance(quint8 instance) { _instance = instance; }
+
 public slots:
 
 	///
@@ -280,6 +287,16 @@ protected:
 	///
 	virtual bool init(const QJsonObject &deviceConfig);
 
+	///
+	/// @brief Initialise the RGBW output stage from the device's "whiteAlgorithm" configuration.
+	///
+	/// Sub-classes supporting RGBW LEDs call it during init and convert via _rgbwConverter when writing.
+	///
+	/// @param[in] deviceConfig the JSON device configuration
+	/// @return True, if success; the device is set in error for unknown algorithms
+	///
+	bool initWhiteAlgorithm(const QJsonObject &deviceConfig);
+
 	///
 	/// @brief Opens the output device.
 	///
@@ -387,9 +404,15 @@ protected:
 	/// The common Logger instance for all LED-devices
 	Logger * _log;
 
+	/// The index of the instance the device belongs to
+	quint8 _instance;
+
 	/// The buffer containing the packed RGB values
 	std::vector<uint8_t> _ledBuffer;
 
+	/// RGB to RGBW output stage of devices supporting RGBW LEDs
+	RGBW::RgbwConverter _rgbwConverter;
+
 	/// Timer object which makes sure that LED data is written at a minimum rate
 	/// e.g. some devices will switch off when they do not receive data at least every 15 seconds
 	QTimer*	_refreshTimer;
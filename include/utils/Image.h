@@ -178,6 +178,27 @@ public:
 		return _d_ptr->size();
 	}
 
+	///
+	/// Check if two images share the same underlying data (e.g. copies of the same grabbed frame)
+	///
+	/// @param other The image to compare with
+	/// @return True if both images reference the same data
+	///
+	bool isSharedWith(const Image & other) const
+	{
+		return _d_ptr.constData() == other._d_ptr.constData();
+	}
+
+	///
+	/// Check if the data is referenced by other images as well, writing to a shared image copies the data first
+	///
+	/// @return True if other images reference the data
+	///
+	bool isShared() const
+	{
+		return _d_ptr.constData()->ref.load() > 1;
+	}
+
 	///
 	/// Clear the image
 	///
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QVector>
+
+#include <utils/Image.h>
+
+///
+/// @brief A few images reused for consecutive frames of a source.
+/// Receivers keep the emitted images for a while, an image is reused once no receiver references it anymore.
+///
+template <typename Pixel_T>
+class ImagePool
+{
+public:
+	explicit ImagePool(int size = 3)
+		: _images(size)
+		, _next(0)
+	{
+	}
+
+	///
+	/// @brief Get an image for writing a new frame, its pixels are undefined.
+	/// Write the pixels before copying the image, its memory is only allocated if no pooled image is free.
+	///
+	/// @param width   The width of the frame
+	/// @param height  The height of the frame
+	/// @return Reference to the pooled image, valid until the next call
+	///
+	Image<Pixel_T>& acquire(unsigned width, unsigned height)
+	{
+		for (Image<Pixel_T>& image : _images)
+		{
+			if (!image.isShared() && image.width() == width && image.height() == height)
+			{
+				return image;
+			}
+		}
+
+		// replace the images in turn, the memory of a referenced one is released by its last receiver
+		Image<Pixel_T>& image = _images[_next];
+		_next = (_next + 1) % _images.size();
+		image = Image<Pixel_T>(width, height);
+		return image;
+	}
+
+private:
+	QVector<Image<Pixel_T>> _images;
+	int _next;
+};
@@ -22,7 +22,8 @@
 
 #include <utils/global_defines.h>
 
-#define LOG_MESSAGE(severity, logger, ...)   (logger)->Message(severity, __FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
+// the level is checked before the arguments are evaluated and formatted
+#define LOG_MESSAGE(severity, logger, ...)   ((logger)->isEnabled(severity) ? (logger)->Message(severity, __FILE__, __FUNCTION__, __LINE__, __VA_ARGS__) : void())
 
 // standard log messages
 #define Debug(logger, ...)   LOG_MESSAGE(Logger::DEBUG  , logger, __VA_ARGS__)
@@ -70,22 +71,43 @@ public:
 	static void     setLogLevel(LogLevel level, const QString & name = "", const QString & subName = "__");
 	static LogLevel getLogLevel(const QString & name = "", const QString & subName = "__");
 
+	///
+	/// @brief Wait until all queued messages are written, e.g. before the process terminates abnormally
+	///
+	static void     flush();
+
+	///
+	/// @brief Write the queued messages from a signal handler. Neither locks nor waits, the writer thread stops
+	/// consuming messages afterwards and later messages are dropped. Best effort: the messages of the first 64 threads are covered.
+	///
+	static void     flushSignalSafe();
+
+	///
+	/// @brief Queue a message for the writer thread. Only the message text is formatted on the calling thread.
+	///
 	void     Message(LogLevel level, const char* sourceFile, const char* func, unsigned int line, const char* fmt, ...);
+
+	///
+	/// @brief Check the level of a message against the global level or the level of this logger
+	/// @param level The level of the message
+	/// @return True, if the message is to be logged
+	///
+	bool     isEnabled(LogLevel level) const
+	{
+		const int globalLevel = int(GLOBAL_MIN_LOG_LEVEL);
+		return (globalLevel == Logger::UNSET) ? (level >= int(_minLevel)) : (level >= globalLevel);
+	}
+
 	void     setMinLevel(LogLevel level) { _minLevel = static_cast<int>(level); }
 	LogLevel getMinLevel() const { return static_cast<LogLevel>(int(_minLevel)); }
 	QString  getName() const { return _name; }
 	QString  getSubName() const { return _subname; }
 
-signals:
-	void newLogMessage(Logger::T_LOG_MESSAGE);
-
 protected:
 	Logger(const QString & name="", const QString & subName = "__", LogLevel minLevel = INFO);
 	~Logger() override;
 
 private:
-	void write(const Logger::T_LOG_MESSAGE & message);
-
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 14, 0))
 	static QRecursiveMutex       MapLock;
 #else
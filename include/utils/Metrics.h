@@ -0,0 +1,96 @@
+#pragma once
+
+// QT includes
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+///
+/// @brief Always available performance counters and latency histograms of the processing pipeline.
+///
+/// Each thread records into its own accumulator, which only this thread writes. Recording takes no lock
+/// and no atomic read-modify-write. Readers sum up the accumulators of all threads.
+///
+class Metrics
+{
+public:
+	/// The measured stages of the pipeline
+	enum Stage
+	{
+		GRAB,
+		DECODE,
+		PROCESS,
+		ADJUST,
+		SMOOTHING,
+		WRITE,
+		STAGE_COUNT
+	};
+
+	/// The counted events per instance
+	enum Counter
+	{
+		/// Updates of the LED colors
+		UPDATES,
+		/// Frames written to the LED device
+		WRITES,
+		/// Frames not written to the LED device, as they arrived within its latch time
+		DROPPED,
+		COUNTER_COUNT
+	};
+
+	static const int MAX_INSTANCES = 256;
+
+	/// Number of histogram buckets, the last one is unbounded
+	static const int BUCKET_COUNT = 14;
+
+	///
+	/// @brief Record the duration of a stage
+	/// @param stage        The stage
+	/// @param nanoseconds  Its duration
+	///
+	static void record(Stage stage, qint64 nanoseconds);
+
+	///
+	/// @brief Count an event of an instance
+	/// @param instance  The instance index
+	/// @param counter   The event
+	///
+	static void count(quint8 instance, Counter counter);
+
+	///
+	/// @brief Get the histograms of all stages and the counters and frame rates of all active instances
+	/// @return The metrics as JSON object
+	///
+	static QJsonObject toJson();
+
+	///
+	/// @brief Get all metrics in the Prometheus text exposition format
+	/// @return The metrics as text
+	///
+	static QByteArray toPrometheus();
+
+	/// @return The name of a stage
+	static const char* stageName(Stage stage);
+
+	///
+	/// @brief Records the lifetime of the timer as duration of a stage
+	///
+	class ScopedTimer
+	{
+	public:
+		explicit ScopedTimer(Stage stage)
+			: _stage(stage)
+		{
+			_timer.start();
+		}
+
+		~ScopedTimer()
+		{
+			Metrics::record(_stage, _timer.nsecsElapsed());
+		}
+
+	private:
+		Stage _stage;
+		QElapsedTimer _timer;
+	};
+};
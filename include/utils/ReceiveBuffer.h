@@ -0,0 +1,64 @@
+#pragma once
+
+// Qt includes
+#include <QVector>
+
+#include <cstdint>
+
+class QIODevice;
+
+///
+/// @brief Receive buffer for messages with a 4 byte (big endian) size header, as used by the Flatbuffers and Protobuffers servers.
+/// Data is read from the socket directly into the buffer and complete messages are provided in place, without copying them.
+/// The unread rest is moved to the front only when the free space at the end does not take the available data.
+///
+class ReceiveBuffer
+{
+public:
+	enum class Result
+	{
+		/// A message is available
+		Message,
+		/// More data is required
+		Incomplete,
+		/// The size header exceeds the limit, the stream can't be recovered
+		Invalid
+	};
+
+	///
+	/// @brief Constructor
+	/// @param maxMessageSize  Maximum size of a message, larger ones are considered invalid
+	///
+	explicit ReceiveBuffer(uint32_t maxMessageSize = 64 * 1024 * 1024);
+
+	///
+	/// @brief Read all available data of the device
+	/// @param device  The socket
+	/// @return The number of bytes read
+	///
+	qint64 readFrom(QIODevice* device);
+
+	///
+	/// @brief Get the next complete message. The message data is valid until the next call of any method.
+	/// @param[out] data  The message without the size header
+	/// @param[out] size  The size of the message
+	/// @return The result
+	///
+	Result nextMessage(const uint8_t*& data, uint32_t& size);
+
+	///
+	/// @brief Discard all data
+	///
+	void clear() { _begin = _end = 0; }
+
+private:
+	///
+	/// @brief Make room for the given number of bytes at the end of the buffer
+	///
+	void reserveTail(int size);
+
+	QVector<uint8_t> _buffer;
+	int _begin;
+	int _end;
+	const uint32_t _maxMessageSize;
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include <QString>
 
+#include <cstddef>
+
 #include <utils/ColorRgb.h>
 #include <utils/ColorRgbw.h>
 
@@ -16,4 +18,59 @@ namespace RGBW {
 
 	WhiteAlgorithm stringToWhiteAlgorithm(const QString& str);
 	void Rgb_to_Rgbw(ColorRgb input, ColorRgbw * output, WhiteAlgorithm algorithm);
+
+	///
+	/// @brief Output stage converting RGB to RGBW colors for LED-devices.
+	/// The algorithm is selected once, its factors are resolved into lookup tables,
+	/// so the per LED conversion is free of branches and floating point operations.
+	/// Results are identical to Rgb_to_Rgbw().
+	///
+	class RgbwConverter
+	{
+	public:
+		explicit RgbwConverter(WhiteAlgorithm algorithm = WhiteAlgorithm::WHITE_OFF);
+
+		///
+		/// @brief Select the white algorithm and build its lookup tables
+		///
+		/// @param[in] algorithm The algorithm, INVALID is treated as WHITE_OFF
+		///
+		void setAlgorithm(WhiteAlgorithm algorithm);
+
+		/// @return The selected algorithm
+		WhiteAlgorithm algorithm() const { return _algorithm; }
+
+		///
+		/// @brief Convert a single color
+		///
+		/// @param[in] input The RGB color
+		/// @return The RGBW color
+		///
+		inline ColorRgbw convert(const ColorRgb& input) const
+		{
+			uint8_t white = qMin(qMin(_white[0][input.red], _white[1][input.green]), _white[2][input.blue]);
+			return ColorRgbw{
+				static_cast<uint8_t>(input.red   - _subtract[0][white]),
+				static_cast<uint8_t>(input.green - _subtract[1][white]),
+				static_cast<uint8_t>(input.blue  - _subtract[2][white]),
+				white };
+		}
+
+		///
+		/// @brief Convert colors straight into an output buffer, e.g. a packet or SPI buffer
+		///
+		/// @param[in]  input  The RGB colors
+		/// @param[in]  count  Number of colors
+		/// @param[out] output Buffer of at least 4 * count bytes, filled with red, green, blue, white per color
+		///
+		void convert(const ColorRgb* input, size_t count, uint8_t* output) const;
+
+	private:
+		WhiteAlgorithm _algorithm;
+
+		/// White share per channel value, the white level is the minimum of all channels
+		uint8_t _white[3][256];
+		/// Amount subtracted from each channel per white level
+		uint8_t _subtract[3][256];
+	};
 }
@@ -195,7 +195,7 @@ namespace hyperion {
 
 			// Get the order of the rgb channels for this led (default is device order)
 			led.colorOrder = stringToColorOrder(ledConfig["colorOrder"].toString(deviceOrderStr));
-			ledString.leds().push_back(led);
+			ledString.append(led);
 		}
 		return ledString;
 	}
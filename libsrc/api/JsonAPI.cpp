@@ -62,6 +62,7 @@
 #include <utils/ColorSys.h>
 #include <utils/Process.h>
 #include <utils/JsonUtils.h>
+#include <utils/Metrics.h>
 
 // bonjour wrapper
 #ifdef ENABLE_AVAHI
@@ -90,6 +91,8 @@ JsonAPI::JsonAPI(QString peerAddress, Logger *log, bool localConnection, QObject
 	_jsonCB = new JsonCB(this);
 	_streaming_logging_activated = false;
 	_ledStreamTimer = new QTimer(this);
+	_ledStreamCompact = false;
+	_ledStreamDelta = false;
 
 	Q_INIT_RESOURCE(JSONRPC_schemas);
 }
@@ -306,8 +309,15 @@ void JsonAPI::handleDeleteEffectCommand(const QJsonObject &message, const QStrin
 	res.isEmpty() ? sendSuccessReply(command, tan) : sendErrorReply(res, command, tan);
 }
 
-void JsonAPI::handleSysInfoCommand(const QJsonObject &, const QString &command, int tan)
+void JsonAPI::handleSysInfoCommand(const QJsonObject &message, const QString &command, int tan)
 {
+	const QString &subc = message["subcommand"].toString();
+	if (subc == "metrics")
+	{
+		sendSuccessDataReply(QJsonDocument(Metrics::toJson()), command + "-" + subc, tan);
+		return;
+	}
+
 	// create result
 	QJsonObject result;
 	QJsonObject info;
@@ -1092,6 +1102,11 @@ void JsonAPI::handleLedColorsCommand(const QJsonObject &message, const QString &
 		_streaming_leds_reply["command"] = command + "-ledstream-update";
 		_streaming_leds_reply["tan"] = tan;
 
+		// optional compact stream: "base64" packed RGB, optionally as delta against the last update
+		_ledStreamCompact = (message["format"].toString("json") == "base64");
+		_ledStreamDelta = _ledStreamCompact && message["delta"].toBool(false);
+		_lastStreamedLedValues.clear();
+
 		connect(_hyperion, &Hyperion::rawLedColors, this, [=](const std::vector<ColorRgb> &ledValues) {
 			_currentLedValues = ledValues;
 
@@ -1116,6 +1131,7 @@ void JsonAPI::handleLedColorsCommand(const QJsonObject &message, const QString &
 		disconnect(_hyperion, &Hyperion::rawLedColors, this, 0);
 		_ledStreamTimer->stop();
 		disconnect(_ledStreamConnection);
+		_lastStreamedLedValues.clear();
 	}
 	else if (subcommand == "imagestream-start")
 	{
@@ -1745,15 +1761,61 @@ void JsonAPI::sendErrorReply(const QString &error, const QString &command, int t
 
 void JsonAPI::streamLedcolorsUpdate(const std::vector<ColorRgb> &ledColors)
 {
+	// nothing changed since the last update, skip it
+	if (!ledColors.empty() && ledColors == _lastStreamedLedValues)
+		return;
+
 	QJsonObject result;
-	QJsonArray leds;
 
-	for (const auto &color : ledColors)
+	if (_ledStreamCompact)
 	{
-		leds << QJsonValue(color.red) << QJsonValue(color.green) << QJsonValue(color.blue);
+		result["format"] = "base64";
+
+		QByteArray data;
+		// the 16bit delta index addresses the first 65536 leds only, larger layouts are always sent as full frames
+		if (_ledStreamDelta && _lastStreamedLedValues.size() == ledColors.size() && ledColors.size() <= 0x10000)
+		{
+			// delta record per changed led: 16bit index (big endian) followed by r,g,b
+			data.reserve(static_cast<int>(ledColors.size()) * 5);
+			for (size_t idx = 0; idx < ledColors.size(); ++idx)
+			{
+				const ColorRgb &color = ledColors[idx];
+				if (color != _lastStreamedLedValues[idx])
+				{
+					data.append(static_cast<char>((idx >> 8) & 0xFF));
+					data.append(static_cast<char>(idx & 0xFF));
+					data.append(static_cast<char>(color.red));
+					data.append(static_cast<char>(color.green));
+					data.append(static_cast<char>(color.blue));
+				}
+			}
+		}
+
+		// a delta is only worth it as long as it is smaller than the full frame
+		if (!data.isEmpty() && static_cast<size_t>(data.size()) < ledColors.size() * sizeof(ColorRgb))
+		{
+			result["delta"] = true;
+		}
+		else
+		{
+			data = QByteArray::fromRawData(reinterpret_cast<const char *>(ledColors.data()), static_cast<int>(ledColors.size() * sizeof(ColorRgb)));
+			result["delta"] = false;
+		}
+
+		result["count"] = static_cast<int>(ledColors.size());
+		result["leds"] = QString(data.toBase64());
+	}
+	else
+	{
+		QJsonArray leds;
+		for (const auto &color : ledColors)
+		{
+			leds << QJsonValue(color.red) << QJsonValue(color.green) << QJsonValue(color.blue);
+		}
+		result["leds"] = leds;
 	}
 
-	result["leds"] = leds;
+	_lastStreamedLedValues = ledColors;
 	_streaming_leds_reply["result"] = result;
 
 	// send the result
@@ -1870,4 +1932,5 @@ void JsonAPI::stopDataConnections()
 	disconnect(_hyperion, &Hyperion::rawLedColors, this, 0);
 	_ledStreamTimer->stop();
 	disconnect(_ledStreamConnection);
+	_lastStreamedLedValues.clear();
 }
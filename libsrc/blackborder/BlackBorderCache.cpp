@@ -0,0 +1,68 @@
+// Blackborder includes
+#include <blackborder/BlackBorderCache.h>
+
+#include <QMutexLocker>
+
+using namespace hyperion;
+
+const int BlackBorderCache::MAX_ENTRIES = 8;
+
+BlackBorderCache::BlackBorderCache()
+	: _enabled(false)
+{
+}
+
+void BlackBorderCache::setEnabled(bool enable)
+{
+	QMutexLocker lock(&_mutex);
+	_enabled = enable;
+	if (!enable)
+	{
+		_entries.clear();
+	}
+}
+
+bool BlackBorderCache::lookup(const Image<ColorRgb>& image, double threshold, DetectionMode mode, BlackBorder& border) const
+{
+	if (!_enabled)
+	{
+		return false;
+	}
+
+	QMutexLocker lock(&_mutex);
+	for (const Entry& entry : _entries)
+	{
+		if (entry.image.isSharedWith(image) && entry.threshold == threshold && entry.mode == mode)
+		{
+			border = entry.border;
+			return true;
+		}
+	}
+	return false;
+}
+
+void BlackBorderCache::insert(const Image<ColorRgb>& image, double threshold, DetectionMode mode, const BlackBorder& border)
+{
+	if (!_enabled)
+	{
+		return;
+	}
+
+	QMutexLocker lock(&_mutex);
+
+	// results of other frames are outdated, release them
+	for (int i = _entries.size() - 1; i >= 0; --i)
+	{
+		if (!_entries[i].image.isSharedWith(image))
+		{
+			_entries.remove(i);
+		}
+	}
+
+	if (_entries.size() >= MAX_ENTRIES)
+	{
+		_entries.remove(0);
+	}
+
+	_entries.append({ image, threshold, mode, border });
+}
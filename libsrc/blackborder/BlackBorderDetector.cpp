@@ -4,6 +4,12 @@
 // BlackBorders includes
 #include <blackborder/BlackBorderDetector.h>
 #include <cmath>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define BLACKBORDER_SSE2
+	#include <emmintrin.h>
+#endif
 
 using namespace hyperion;
 
@@ -27,3 +33,67 @@ uint8_t BlackBorderDetector::calculateThreshold(double threshold) const
 
 	return blackborderThreshold;
 }
+
+namespace {
+	/// Number of bytes checked at once
+	const int BLOCK_SIZE = 16;
+}
+
+///
+/// Checks if any byte of a block reaches the threshold
+///
+static inline bool blockReachesThreshold(const uint8_t * data, uint8_t threshold)
+{
+#ifdef BLACKBORDER_SSE2
+	const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+	// a byte reaches the threshold, if it is the maximum of itself and the threshold
+	const __m128i reached = _mm_cmpeq_epi8(_mm_max_epu8(bytes, _mm_set1_epi8(char(threshold))), bytes);
+	return _mm_movemask_epi8(reached) != 0;
+#else
+	// branchless maximum, which is vectorized by the compiler (e.g. NEON)
+	uint8_t maximum = 0;
+	for (int i = 0; i < BLOCK_SIZE; ++i)
+	{
+		maximum = std::max(maximum, data[i]);
+	}
+	return maximum >= threshold;
+#endif
+}
+
+int BlackBorderDetector::firstNonBlackByte(const uint8_t * data, int size) const
+{
+	// skip the black blocks, the remaining bytes are checked one by one
+	int i = 0;
+	while (i + BLOCK_SIZE <= size && !blockReachesThreshold(data + i, _blackborderThreshold))
+	{
+		i += BLOCK_SIZE;
+	}
+
+	for (; i < size; ++i)
+	{
+		if (data[i] >= _blackborderThreshold)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+int BlackBorderDetector::lastNonBlackByte(const uint8_t * data, int size) const
+{
+	// skip the black blocks, the remaining bytes are checked one by one
+	int i = size;
+	while (i - BLOCK_SIZE >= 0 && !blockReachesThreshold(data + i - BLOCK_SIZE, _blackborderThreshold))
+	{
+		i -= BLOCK_SIZE;
+	}
+
+	for (--i; i >= 0; --i)
+	{
+		if (data[i] >= _blackborderThreshold)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
@@ -15,7 +15,7 @@ BlackBorderProcessor::BlackBorderProcessor(Hyperion* hyperion, QObject* parent)
 	, _borderSwitchCnt(50)
 	, _maxInconsistentCnt(10)
 	, _blurRemoveCnt(1)
-	, _detectionMode("default")
+	, _detectionMode(DetectionMode::DEFAULT)
 	, _detector(nullptr)
 	, _currentBorder({true, -1, -1})
 	, _previousDetectedBorder({true, -1, -1})
@@ -57,7 +57,8 @@ void BlackBorderProcessor::handleSettingsUpdate(settings::type type, const QJson
 			_borderSwitchCnt = obj["borderFrameCnt"].toInt(50);
 			_maxInconsistentCnt = obj["maxInconsistentCnt"].toInt(10);
 			_blurRemoveCnt = obj["blurRemoveCnt"].toInt(1);
-			_detectionMode = obj["mode"].toString("default");
+			const QString detectionMode = obj["mode"].toString("default");
+			_detectionMode = detectionModeFromString(detectionMode);
 			const double newThreshold = obj["threshold"].toDouble(5.0) / 100.0;
 
 			if (_oldThreshold != newThreshold)
@@ -69,7 +70,7 @@ void BlackBorderProcessor::handleSettingsUpdate(settings::type type, const QJson
 				_detector = new BlackBorderDetector(newThreshold);
 			}
 
-			Debug(Logger::getInstance("BLACKBORDER", "I"+QString::number(_hyperion->getInstanceIndex())), "Set mode to: %s", QSTRING_CSTR(_detectionMode));
+			Debug(Logger::getInstance("BLACKBORDER", "I"+QString::number(_hyperion->getInstanceIndex())), "Set mode to: %s", QSTRING_CSTR(detectionMode));
 
 			// eval the comp state
 			handleCompStateChangeRequest(hyperion::COMP_BLACKBORDER, obj["enable"].toBool(true));
@@ -77,6 +78,18 @@ void BlackBorderProcessor::handleSettingsUpdate(settings::type type, const QJson
 	}
 }
 
+DetectionMode BlackBorderProcessor::detectionModeFromString(const QString& mode)
+{
+	if (mode == "classic")
+		return DetectionMode::CLASSIC;
+	if (mode == "osd")
+		return DetectionMode::OSD;
+	if (mode == "letterbox")
+		return DetectionMode::LETTERBOX;
+
+	return DetectionMode::DEFAULT;
+}
+
 void BlackBorderProcessor::handleCompStateChangeRequest(hyperion::Components component, bool enable)
 {
 	if(component == hyperion::COMP_BLACKBORDER)
@@ -122,6 +135,12 @@ bool BlackBorderProcessor::enabled() const
 	return _enabled;
 }
 
+bool BlackBorderProcessor::isSettled() const
+{
+	// a border waiting for its consistency count is switched by further frames only
+	return !_enabled || (_inconsistentCnt == 0 && _previousDetectedBorder == _currentBorder);
+}
+
 void BlackBorderProcessor::setEnabled(bool enable)
 {
 	_enabled = enable;
@@ -5,6 +5,7 @@
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QThreadStorage>
+#include <QHash>
 #include <QUuid>
 #include <QDir>
 
@@ -15,6 +16,7 @@
 // not in header because of linking
 static QString _rootPath;
 static QThreadStorage<QSqlDatabase> _databasePool;
+static QThreadStorage<QHash<QString, QSqlQuery>> _statementPool;
 
 DBManager::DBManager(QObject* parent)
 	: QObject(parent)
@@ -53,6 +55,13 @@ QSqlDatabase DBManager::getDB() const
 			Error(_log, QSTRING_CSTR(db.lastError().text()));
 			throw std::runtime_error("Failed to open database connection!");
 		}
+
+		// write ahead log: writers don't block readers and commits need less syncs, which is noticeable on SD cards
+		QSqlQuery pragma(db);
+		if(!pragma.exec("PRAGMA journal_mode=WAL") || !pragma.exec("PRAGMA synchronous=NORMAL"))
+		{
+			Warning(_log, "Failed to enable write ahead logging: %s", QSTRING_CSTR(pragma.lastError().text()));
+		}
 		return db;
 	}
 }
@@ -77,8 +86,6 @@ bool DBManager::createRecord(const VectorPair& conditions, const QVariantMap& co
 	}
 
 	QSqlDatabase idb = getDB();
-	QSqlQuery query(idb);
-	query.setForwardOnly(true);
 
 	QVariantList cValues;
 	QStringList prep;
@@ -100,7 +107,7 @@ bool DBManager::createRecord(const VectorPair& conditions, const QVariantMap& co
 		cValues << pair.second;
 		placeh.append("?");
 	}
-	query.prepare(QString("INSERT INTO %1 ( %2 ) VALUES ( %3 )").arg(_table,prep.join(", ")).arg(placeh.join(", ")));
+	QSqlQuery query = prepareQuery(QString("INSERT INTO %1 ( %2 ) VALUES ( %3 )").arg(_table,prep.join(", ")).arg(placeh.join(", ")));
 	// add column & condition values
 	doAddBindValue(query, cValues);
 	if(!query.exec())
@@ -117,8 +124,6 @@ bool DBManager::recordExists(const VectorPair& conditions) const
 		return false;
 
 	QSqlDatabase idb = getDB();
-	QSqlQuery query(idb);
-	query.setForwardOnly(true);
 
 	QStringList prepCond;
 	QVariantList bindVal;
@@ -129,7 +134,7 @@ bool DBManager::recordExists(const VectorPair& conditions) const
 		prepCond << pair.first+"=?";
 		bindVal << pair.second;
 	}
-	query.prepare(QString("SELECT * FROM %1 %2").arg(_table,prepCond.join(" ")));
+	QSqlQuery query = prepareQuery(QString("SELECT * FROM %1 %2").arg(_table,prepCond.join(" ")));
 	doAddBindValue(query, bindVal);
 	if(!query.exec())
 	{
@@ -137,15 +142,10 @@ bool DBManager::recordExists(const VectorPair& conditions) const
 		return false;
 	}
 
-	int entry = 0;
-	while (query.next()) {
-		entry++;
-	}
-
-	if(entry)
-		return true;
-
-	return false;
+	// a single row is enough, release the statement for the next use
+	const bool exists = query.next();
+	query.finish();
+	return exists;
 }
 
 bool DBManager::updateRecord(const VectorPair& conditions, const QVariantMap& columns) const
@@ -156,8 +156,6 @@ bool DBManager::updateRecord(const VectorPair& conditions, const QVariantMap& co
 	}
 
 	QSqlDatabase idb = getDB();
-	QSqlQuery query(idb);
-	query.setForwardOnly(true);
 
 	QVariantList values;
 	QStringList prep;
@@ -183,7 +181,7 @@ bool DBManager::updateRecord(const VectorPair& conditions, const QVariantMap& co
 		prepBindVal << pair.second;
 	}
 
-	query.prepare(QString("UPDATE %1 SET %2 %3").arg(_table,prep.join(", ")).arg(prepCond.join(" ")));
+	QSqlQuery query = prepareQuery(QString("UPDATE %1 SET %2 %3").arg(_table,prep.join(", ")).arg(prepCond.join(" ")));
 	// add column values
 	doAddBindValue(query, values);
 	// add condition values
@@ -199,8 +197,6 @@ bool DBManager::updateRecord(const VectorPair& conditions, const QVariantMap& co
 bool DBManager::getRecord(const VectorPair& conditions, QVariantMap& results, const QStringList& tColumns, const QStringList& tOrder) const
 {
 	QSqlDatabase idb = getDB();
-	QSqlQuery query(idb);
-	query.setForwardOnly(true);
 
 	QString sColumns("*");
 	if(!tColumns.isEmpty())
@@ -223,7 +219,7 @@ bool DBManager::getRecord(const VectorPair& conditions, QVariantMap& results, co
 		prepCond << pair.first+"=?";
 		bindVal << pair.second;
 	}
-	query.prepare(QString("SELECT %1 FROM %2%3%4").arg(sColumns,_table).arg(prepCond.join(" ")).arg(sOrder));
+	QSqlQuery query = prepareQuery(QString("SELECT %1 FROM %2%3%4").arg(sColumns,_table).arg(prepCond.join(" ")).arg(sOrder));
 	doAddBindValue(query, bindVal);
 
 	if(!query.exec())
@@ -240,6 +236,7 @@ bool DBManager::getRecord(const VectorPair& conditions, QVariantMap& results, co
 	{
 		results[rec.fieldName(i)] = rec.value(i);
 	}
+	query.finish();
 
 	return true;
 }
@@ -247,8 +244,6 @@ bool DBManager::getRecord(const VectorPair& conditions, QVariantMap& results, co
 bool DBManager::getRecords(QVector<QVariantMap>& results, const QStringList& tColumns, const QStringList& tOrder) const
 {
 	QSqlDatabase idb = getDB();
-	QSqlQuery query(idb);
-	query.setForwardOnly(true);
 
 	QString sColumns("*");
 	if(!tColumns.isEmpty())
@@ -261,7 +256,7 @@ bool DBManager::getRecords(QVector<QVariantMap>& results, const QStringList& tCo
 		sOrder.append(tOrder.join(", "));
 	}
 
-	query.prepare(QString("SELECT %1 FROM %2%3").arg(sColumns,_table,sOrder));
+	QSqlQuery query = prepareQuery(QString("SELECT %1 FROM %2%3").arg(sColumns,_table,sOrder));
 
 	if(!query.exec())
 	{
@@ -280,6 +275,7 @@ bool DBManager::getRecords(QVector<QVariantMap>& results, const QStringList& tCo
 		}
 		results.append(entry);
 	}
+	query.finish();
 
 	return true;
 }
@@ -301,7 +297,6 @@ bool DBManager::deleteRecord(const VectorPair& conditions) const
 	if(recordExists(conditions))
 	{
 		QSqlDatabase idb = getDB();
-		QSqlQuery query(idb);
 
 		// prep conditions
 		QStringList prepCond("WHERE");
@@ -313,7 +308,7 @@ bool DBManager::deleteRecord(const VectorPair& conditions) const
 			bindValues << pair.second;
 		}
 
-		query.prepare(QString("DELETE FROM %1 %2").arg(_table,prepCond.join(" ")));
+		QSqlQuery query = prepareQuery(QString("DELETE FROM %1 %2").arg(_table,prepCond.join(" ")));
 		doAddBindValue(query, bindValues);
 		if(!query.exec())
 		{
@@ -418,6 +413,64 @@ bool DBManager::deleteTable(const QString& table) const
 	return true;
 }
 
+QSqlQuery DBManager::prepareQuery(const QString& statement) const
+{
+	QHash<QString, QSqlQuery>& statements = _statementPool.localData();
+	auto it = statements.constFind(statement);
+	if(it != statements.constEnd())
+	{
+		return it.value();
+	}
+
+	QSqlQuery query(getDB());
+	query.setForwardOnly(true);
+	// failed statements (e.g. of a missing table) are not kept, exec() reports the error
+	if(query.prepare(statement))
+	{
+		statements.insert(statement, query);
+	}
+	return query;
+}
+
+bool DBManager::startTransaction() const
+{
+	if ( _readonlyMode )
+	{
+		return false;
+	}
+
+	QSqlDatabase idb = getDB();
+	if(!idb.transaction())
+	{
+		Error(_log, "Failed to start transaction: %s", QSTRING_CSTR(idb.lastError().text()));
+		return false;
+	}
+	return true;
+}
+
+bool DBManager::commitTransaction() const
+{
+	QSqlDatabase idb = getDB();
+	if(!idb.commit())
+	{
+		Error(_log, "Failed to commit transaction: %s", QSTRING_CSTR(idb.lastError().text()));
+		idb.rollback();
+		return false;
+	}
+	return true;
+}
+
+bool DBManager::rollbackTransaction() const
+{
+	QSqlDatabase idb = getDB();
+	if(!idb.rollback())
+	{
+		Error(_log, "Failed to roll back transaction: %s", QSTRING_CSTR(idb.lastError().text()));
+		return false;
+	}
+	return true;
+}
+
 void DBManager::doAddBindValue(QSqlQuery& query, const QVariantList& variants) const
 {
 	for(const auto& variant : variants)
@@ -0,0 +1,62 @@
+// effect engine includes
+#include <effectengine/AnimationCache.h>
+
+#include <QMutexLocker>
+
+const qint64 AnimationCache::MEMORY_BUDGET = 64 * 1024 * 1024;
+
+bool AnimationCache::Key::operator==(const Key& other) const
+{
+	return modified == other.modified && isSameSource(other);
+}
+
+bool AnimationCache::Key::isSameSource(const Key& other) const
+{
+	return grayscale == other.grayscale
+		&& crop == other.crop
+		&& source == other.source;
+}
+
+QSharedPointer<const AnimationCache::Animation> AnimationCache::find(const Key& key)
+{
+	QMutexLocker lock(&_mutex);
+	for (int i = 0; i < _entries.size(); ++i)
+	{
+		if (_entries[i].key == key)
+		{
+			_entries.move(i, 0);
+			return _entries.first().animation;
+		}
+	}
+	return QSharedPointer<const Animation>();
+}
+
+void AnimationCache::insert(const Key& key, const QSharedPointer<const Animation>& animation)
+{
+	if (animation.isNull() || animation->size > MEMORY_BUDGET)
+	{
+		return;
+	}
+
+	QMutexLocker lock(&_mutex);
+
+	// replace a previous version of the same source, e.g. the frames of a file before it was changed
+	for (int i = 0; i < _entries.size(); ++i)
+	{
+		if (_entries[i].key.isSameSource(key))
+		{
+			_size -= _entries[i].animation->size;
+			_entries.removeAt(i);
+			break;
+		}
+	}
+
+	while (!_entries.isEmpty() && _size + animation->size > MEMORY_BUDGET)
+	{
+		_size -= _entries.last().animation->size;
+		_entries.removeLast();
+	}
+
+	_entries.prepend({ key, animation });
+	_size += animation->size;
+}
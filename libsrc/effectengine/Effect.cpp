@@ -1,11 +1,14 @@
 // Qt includes
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QResource>
+#include <QScopedPointer>
 
 // effect engin eincludes
 #include <effectengine/Effect.h>
 #include <effectengine/EffectModule.h>
+#include <effectengine/NativeEffect.h>
 #include <utils/Logger.h>
 #include <hyperion/Hyperion.h>
 
@@ -14,6 +17,9 @@
 
 const int Effect::ENDLESS = -1;
 
+/// Maximum time to wait for the next clip frame without checking for an interruption
+static const qint64 MAX_CLIP_WAIT_US = 50000;
+
 Effect::Effect(Hyperion *hyperion, int priority, int timeout, const QString &script, const QString &name, const QJsonObject &args, const QString &imageData)
 	: QThread()
 	, _hyperion(hyperion)
@@ -28,9 +34,11 @@ Effect::Effect(Hyperion *hyperion, int priority, int timeout, const QString &scr
 	, _interupt(false)
 	, _imageSize(hyperion->getLedGridSize())
 	, _image(_imageSize,QImage::Format_ARGB32_Premultiplied)
+	, _clipEnabled(false)
+	, _outputRate(0.0)
+	, _frameDue(0)
 {
-	_colors.resize(_hyperion->getLedCount());
-	_colors.fill(ColorRgb::BLACK);
+	_colors.resize(_hyperion->getLedCount(), ColorRgb::BLACK);
 
 	_log = Logger::getInstance("EFFECTENGINE");
 
@@ -67,6 +75,35 @@ int Effect::getRemaining() const
 	return timeout;
 }
 
+void Effect::enableClip(const EffectClip::Key& key, const LedString& leds)
+{
+	_clipEnabled = true;
+	_clipKey = key;
+	_clipLeds = leds;
+}
+
+Image<ColorRgb> Effect::toRgbImage(const QImage& qimage)
+{
+	const int width = qimage.width();
+	const int height = qimage.height();
+
+	Image<ColorRgb> image(width, height);
+	ColorRgb* output = image.memptr();
+	for (int y = 0; y < height; ++y, output += width)
+	{
+		// plain shifts without branches, which the compiler can vectorize
+		const QRgb* scanline = reinterpret_cast<const QRgb*>(qimage.constScanLine(y));
+		for (int x = 0; x < width; ++x)
+		{
+			const QRgb pixel = scanline[x];
+			output[x].red   = static_cast<uint8_t>(pixel >> 16);
+			output[x].green = static_cast<uint8_t>(pixel >> 8);
+			output[x].blue  = static_cast<uint8_t>(pixel);
+		}
+	}
+	return image;
+}
+
 void Effect::setModuleParameters()
 {
 	// import the buildtin Hyperion module
@@ -92,17 +129,65 @@ void Effect::setModuleParameters()
 	Py_XDECREF(module);
 }
 
-void Effect::run()
+void Effect::setEndTime()
 {
-	PythonProgram program(_name, _log);
-
-	setModuleParameters();
-
 	// Set the end time if applicable
 	if (_timeout > 0)
 	{
 		_endTime = QDateTime::currentMSecsSinceEpoch() + _timeout;
 	}
+}
+
+void Effect::playClip(const EffectClip& clip)
+{
+	QElapsedTimer timer;
+	timer.start();
+
+	// frames are due relative to the start, waiting doesn't accumulate a drift
+	qint64 due = 0;
+	for (int frame = 0; !isInterruptionRequested(); frame = (frame + 1) % clip.frames.size())
+	{
+		emit setInput(_priority, clip.frames[frame], getRemaining(), false);
+
+		due += clip.durations[frame];
+		qint64 remaining = due - timer.nsecsElapsed() / 1000;
+		while (remaining > 0 && !isInterruptionRequested())
+		{
+			QThread::usleep(static_cast<unsigned long>(qMin(remaining, MAX_CLIP_WAIT_US)));
+			remaining = due - timer.nsecsElapsed() / 1000;
+		}
+	}
+}
+
+void Effect::run()
+{
+	// a recorded clip of the effect is replayed without rendering it again
+	if (_clipEnabled)
+	{
+		QSharedPointer<const EffectClip> clip = EffectClipCache::getInstance()->find(_clipKey);
+		if (!clip.isNull())
+		{
+			Debug(_log, "Replay recorded clip of %s", QSTRING_CSTR(_script));
+			setEndTime();
+			playClip(*clip);
+			return;
+		}
+	}
+
+	// built-in effects with a native implementation run without a Python interpreter
+	QScopedPointer<NativeEffect> nativeEffect(NativeEffect::create(_script));
+	if (!nativeEffect.isNull())
+	{
+		Debug(_log, "Run native implementation of %s", QSTRING_CSTR(_script));
+		setEndTime();
+		nativeEffect->run(this);
+		return;
+	}
+
+	PythonProgram program(_name, _log);
+
+	setModuleParameters();
+	setEndTime();
 
 	// Run the effect script
 	QFile file (_script);
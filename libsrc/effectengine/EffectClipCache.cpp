@@ -0,0 +1,58 @@
+// effect engine includes
+#include <effectengine/EffectClipCache.h>
+
+#include <QMutexLocker>
+
+const qint64 EffectClipCache::MEMORY_BUDGET = 16 * 1024 * 1024;
+
+bool EffectClip::Key::operator==(const Key& other) const
+{
+	return layoutHash == other.layoutHash
+		&& latchTime == other.latchTime
+		&& script == other.script
+		&& args == other.args;
+}
+
+QSharedPointer<const EffectClip> EffectClipCache::find(const EffectClip::Key& key)
+{
+	QMutexLocker lock(&_mutex);
+	for (int i = 0; i < _entries.size(); ++i)
+	{
+		if (_entries[i].key == key)
+		{
+			_entries.move(i, 0);
+			return _entries.first().clip;
+		}
+	}
+	return QSharedPointer<const EffectClip>();
+}
+
+void EffectClipCache::insert(const EffectClip::Key& key, const QSharedPointer<const EffectClip>& clip)
+{
+	if (clip.isNull() || !fits(clip->size))
+	{
+		return;
+	}
+
+	QMutexLocker lock(&_mutex);
+
+	// replace a clip recorded concurrently by another instance
+	for (int i = 0; i < _entries.size(); ++i)
+	{
+		if (_entries[i].key == key)
+		{
+			_size -= _entries[i].clip->size;
+			_entries.removeAt(i);
+			break;
+		}
+	}
+
+	while (!_entries.isEmpty() && _size + clip->size > MEMORY_BUDGET)
+	{
+		_size -= _entries.last().clip->size;
+		_entries.removeLast();
+	}
+
+	_entries.prepend({ key, clip });
+	_size += clip->size;
+}
@@ -180,6 +180,26 @@ int EffectEngine::runEffectScript(const QString &script, const QString &name, co
 	connect(_hyperion, &Hyperion::finished, effect, &Effect::requestInterruption, Qt::DirectConnection);
 	_activeEffects.push_back(effect);
 
+	// the smoothing writes the LEDs at its own rate, effects may align their frames to it
+	const QJsonObject smoothing = _hyperion->getSetting(settings::SMOOTHING).object();
+	if (smoothing["enable"].toBool(true))
+	{
+		effect->setOutputRate(args["smoothing-custom-settings"].toBool()
+			? args["smoothing-updateFrequency"].toDouble(25.0)
+			: smoothing["updateFrequency"].toDouble(25.0));
+	}
+
+	// deterministic effects are recorded once per layout and replayed on the next start
+	if (_effectFileHandler->isClipRecordingEnabled())
+	{
+		EffectClip::Key key;
+		key.script = script;
+		key.args = args;
+		key.layoutHash = qHash(_hyperion->getSetting(settings::LEDS).toJson(QJsonDocument::Compact));
+		key.latchTime = _hyperion->getLatchTime();
+		effect->enableClip(key, _hyperion->getLedString());
+	}
+
 	// start the effect
 	Debug(_log, "Start the effect: name [%s], smoothCfg [%u]", QSTRING_CSTR(name), smoothCfg);
 	_hyperion->registerInput(priority, hyperion::COMP_EFFECT, origin, name ,smoothCfg);
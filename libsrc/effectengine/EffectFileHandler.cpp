@@ -16,6 +16,7 @@ EffectFileHandler::EffectFileHandler(const QString& rootPath, const QJsonDocumen
 	: QObject(parent)
 	, _log(Logger::getInstance("EFFECTFILES"))
 	, _rootPath(rootPath)
+	, _clipRecording(false)
 {
 	EffectFileHandler::efhInstance = this;
 
@@ -30,6 +31,7 @@ void EffectFileHandler::handleSettingsUpdate(settings::type type, const QJsonDoc
 	if (type == settings::EFFECTS)
 	{
 		_effectConfig = config.object();
+		_clipRecording = _effectConfig["clips"].toBool(false);
 		// update effects and schemas
 		updateEffects();
 	}
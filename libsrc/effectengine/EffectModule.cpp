@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include <effectengine/Effect.h>
 #include <effectengine/EffectModule.h>
@@ -16,10 +18,59 @@
 #include <QNetworkReply>
 #include <QNetworkAccessManager>
 #include <QEventLoop>
+#include <QFileInfo>
+
+/// Maximum time to wait for the next frame without checking for an interruption
+static const qint64 MAX_FRAME_WAIT_NS = 50000000;
+
+/// Frame rate if neither the effect nor the smoothing provide one
+static const double DEFAULT_FPS = 25.0;
 
 // Get the effect from the capsule
 #define getEffect() static_cast<Effect*>((Effect*)PyCapsule_Import("hyperion.__effectObj", 0))
 
+namespace {
+
+///
+/// @brief Read access to the data of any Python object which supports the buffer protocol
+/// (bytes, bytearray, memoryview, numpy arrays, ...), without copying it.
+/// The buffer is released when leaving the scope.
+///
+class PyBufferView
+{
+public:
+	explicit PyBufferView(PyObject* object)
+		: _valid(PyObject_GetBuffer(object, &_view, PyBUF_C_CONTIGUOUS) == 0)
+	{
+		if (!_valid)
+		{
+			// replaced by the error of the caller
+			PyErr_Clear();
+		}
+	}
+
+	~PyBufferView()
+	{
+		if (_valid)
+		{
+			PyBuffer_Release(&_view);
+		}
+	}
+
+	PyBufferView(const PyBufferView&) = delete;
+	PyBufferView& operator=(const PyBufferView&) = delete;
+
+	bool isValid() const { return _valid; }
+	const void* data() const { return _view.buf; }
+	size_t size() const { return static_cast<size_t>(_view.len); }
+
+private:
+	Py_buffer _view;
+	bool _valid;
+};
+
+}
+
 // create the hyperion module
 struct PyModuleDef EffectModule::moduleDef = {
 	PyModuleDef_HEAD_INIT,
@@ -100,6 +151,7 @@ PyMethodDef EffectModule::effectMethods[] = {
 	{"setImage"              , EffectModule::wrapSetImage              , METH_VARARGS, "Set a new image to process and determine new led colors."},
 	{"getImage"              , EffectModule::wrapGetImage              , METH_VARARGS, "get image data from file."},
 	{"abort"                 , EffectModule::wrapAbort                 , METH_NOARGS,  "Check if the effect should abort execution."},
+	{"waitForNextFrame"      , EffectModule::wrapWaitForNextFrame      , METH_VARARGS, "Wait for the next frame deadline of the given fps, returns the number of missed deadlines."},
 	{"imageShow"             , EffectModule::wrapImageShow             , METH_VARARGS,  "set current effect image to hyperion core."},
 	{"imageLinearGradient"   , EffectModule::wrapImageLinearGradient   , METH_VARARGS,  ""},
 	{"imageConicalGradient"  , EffectModule::wrapImageConicalGradient  , METH_VARARGS,  ""},
@@ -125,6 +177,8 @@ PyMethodDef EffectModule::effectMethods[] = {
 
 PyObject* EffectModule::wrapSetColor(PyObject *self, PyObject *args)
 {
+	Effect* effect = getEffect();
+
 	// check the number of arguments
 	int argCount = PyTuple_Size(args);
 	if (argCount == 3)
@@ -133,39 +187,35 @@ PyObject* EffectModule::wrapSetColor(PyObject *self, PyObject *args)
 		ColorRgb color;
 		if (PyArg_ParseTuple(args, "bbb", &color.red, &color.green, &color.blue))
 		{
-			getEffect()->_colors.fill(color);
-			QVector<ColorRgb> _cQV = getEffect()->_colors;
-			emit getEffect()->setInput(getEffect()->_priority, std::vector<ColorRgb>( _cQV.begin(), _cQV.end() ), getEffect()->getRemaining(), false);
+			std::fill(effect->_colors.begin(), effect->_colors.end(), color);
+			emit effect->setInput(effect->_priority, effect->_colors, effect->getRemaining(), false);
 			Py_RETURN_NONE;
 		}
 		return nullptr;
 	}
 	else if (argCount == 1)
 	{
-		// bytearray of values
-		PyObject * bytearray = nullptr;
-		if (PyArg_ParseTuple(args, "O", &bytearray))
+		// bytes, bytearray, memoryview or any other object providing a byte buffer
+		PyObject * object = nullptr;
+		if (PyArg_ParseTuple(args, "O", &object))
 		{
-			if (PyByteArray_Check(bytearray))
+			PyBufferView buffer(object);
+			if (!buffer.isValid())
 			{
-				size_t length = PyByteArray_Size(bytearray);
-				if (length == 3 * static_cast<size_t>(getEffect()->_hyperion->getLedCount()))
-				{
-					char * data = PyByteArray_AS_STRING(bytearray);
-					memcpy(getEffect()->_colors.data(), data, length);
-					QVector<ColorRgb> _cQV = getEffect()->_colors;
-					emit getEffect()->setInput(getEffect()->_priority, std::vector<ColorRgb>( _cQV.begin(), _cQV.end() ), getEffect()->getRemaining(), false);
-					Py_RETURN_NONE;
-				}
-				else
-				{
-					PyErr_SetString(PyExc_RuntimeError, "Length of bytearray argument should be 3*ledCount");
-					return nullptr;
-				}
+				PyErr_SetString(PyExc_RuntimeError, "Argument does not provide a contiguous byte buffer");
+				return nullptr;
+			}
+
+			size_t length = buffer.size();
+			if (length == 3 * effect->_colors.size())
+			{
+				memcpy(effect->_colors.data(), buffer.data(), length);
+				emit effect->setInput(effect->_priority, effect->_colors, effect->getRemaining(), false);
+				Py_RETURN_NONE;
 			}
 			else
 			{
-				PyErr_SetString(PyExc_RuntimeError, "Argument is not a bytearray");
+				PyErr_SetString(PyExc_RuntimeError, "Length of buffer argument should be 3*ledCount");
 				return nullptr;
 			}
 		}
@@ -183,31 +233,29 @@ PyObject* EffectModule::wrapSetColor(PyObject *self, PyObject *args)
 
 PyObject* EffectModule::wrapSetImage(PyObject *self, PyObject *args)
 {
-	// bytearray of values
+	// bytes, bytearray, memoryview or any other object providing a byte buffer
 	int width, height;
-	PyObject * bytearray = nullptr;
-	if (PyArg_ParseTuple(args, "iiO", &width, &height, &bytearray))
+	PyObject * object = nullptr;
+	if (PyArg_ParseTuple(args, "iiO", &width, &height, &object))
 	{
-		if (PyByteArray_Check(bytearray))
+		PyBufferView buffer(object);
+		if (!buffer.isValid())
 		{
-			int length = PyByteArray_Size(bytearray);
-			if (length == 3 * width * height)
-			{
-				Image<ColorRgb> image(width, height);
-				char * data = PyByteArray_AS_STRING(bytearray);
-				memcpy(image.memptr(), data, length);
-				emit getEffect()->setInputImage(getEffect()->_priority, image, getEffect()->getRemaining(), false);
-				Py_RETURN_NONE;
-			}
-			else
-			{
-				PyErr_SetString(PyExc_RuntimeError, "Length of bytearray argument should be 3*width*height");
-				return nullptr;
-			}
+			PyErr_SetString(PyExc_RuntimeError, "Argument 3 does not provide a contiguous byte buffer");
+			return nullptr;
+		}
+
+		if (width > 0 && height > 0 && buffer.size() == 3 * static_cast<size_t>(width) * static_cast<size_t>(height))
+		{
+			Effect* effect = getEffect();
+			Image<ColorRgb> image(width, height);
+			memcpy(image.memptr(), buffer.data(), buffer.size());
+			emit effect->setInputImage(effect->_priority, image, effect->getRemaining(), false);
+			Py_RETURN_NONE;
 		}
 		else
 		{
-			PyErr_SetString(PyExc_RuntimeError, "Argument 3 is not a bytearray");
+			PyErr_SetString(PyExc_RuntimeError, "Length of buffer argument should be 3*width*height");
 			return nullptr;
 		}
 	}
@@ -215,21 +263,18 @@ PyObject* EffectModule::wrapSetImage(PyObject *self, PyObject *args)
 	{
 		return nullptr;
 	}
-
-	// error
-	PyErr_SetString(PyExc_RuntimeError, "Unknown error");
-	return nullptr;
 }
 
 PyObject* EffectModule::wrapGetImage(PyObject *self, PyObject *args)
 {
-	QBuffer buffer;
-	QImageReader reader;
-	char *source;
+	Effect* effect = getEffect();
+	char *source = nullptr;
 	int cropLeft = 0, cropTop = 0, cropRight = 0, cropBottom = 0;
 	int grayscale = false;
 
-	if (getEffect()->_imageData.isEmpty())
+	AnimationCache::Key key;
+	bool cacheable = true;
+	if (effect->_imageData.isEmpty())
 	{
 		Q_INIT_RESOURCE(EffectEngine);
 
@@ -239,7 +284,68 @@ PyObject* EffectModule::wrapGetImage(PyObject *self, PyObject *args)
 			return nullptr;
 		}
 
-		const QUrl url = QUrl(source);
+		key.source = QString::fromUtf8(source);
+		const QUrl url(key.source);
+		if (url.isValid() && !url.scheme().isEmpty() && !url.isLocalFile())
+		{
+			// a remote image may change at any time without a way to notice it
+			cacheable = false;
+		}
+		else
+		{
+			if (key.source.mid(0, 1)  == ":")
+				key.source = ":/effects/"+key.source.mid(1);
+
+			key.modified = QFileInfo(url.isLocalFile() ? url.toLocalFile() : key.source).lastModified();
+		}
+	}
+	else
+	{
+		PyArg_ParseTuple(args, "|siiiip", &source, &cropLeft, &cropTop, &cropRight, &cropBottom, &grayscale);
+		key.source = effect->_imageData;
+	}
+	key.crop = QMargins(cropLeft, cropTop, cropRight, cropBottom);
+	key.grayscale = grayscale;
+
+	// restarted effects play the frames decoded before
+	QSharedPointer<const AnimationCache::Animation> animation;
+	if (cacheable)
+	{
+		animation = AnimationCache::getInstance()->find(key);
+	}
+	if (animation.isNull())
+	{
+		animation = decodeImage(key, !effect->_imageData.isEmpty());
+		if (animation.isNull())
+		{
+			return nullptr;
+		}
+		if (cacheable)
+		{
+			AnimationCache::getInstance()->insert(key, animation);
+		}
+	}
+
+	// scripts may modify the frames, each call gets its own copy of the cached ones
+	const QVector<Image<ColorRgb>>& frames = animation->frames;
+	PyObject *result = PyList_New(frames.size());
+	for (int i = 0; i < frames.size(); ++i)
+	{
+		const Image<ColorRgb>& image = frames[i];
+		PyObject* imageData = PyByteArray_FromStringAndSize(reinterpret_cast<const char*>(image.memptr()), image.size());
+		PyList_SET_ITEM(result, i, Py_BuildValue("{s:i,s:i,s:N}", "imageWidth", image.width(), "imageHeight", image.height(), "imageData", imageData));
+	}
+	return result;
+}
+
+QSharedPointer<const AnimationCache::Animation> EffectModule::decodeImage(const AnimationCache::Key& key, bool embedded)
+{
+	QBuffer buffer;
+	QImageReader reader;
+
+	if (!embedded)
+	{
+		const QUrl url = QUrl(key.source);
 		if (url.isValid())
 		{
 			QNetworkAccessManager *networkManager = new QNetworkAccessManager();
@@ -258,83 +364,77 @@ PyObject* EffectModule::wrapGetImage(PyObject *self, PyObject *args)
 			}
 
 			delete networkReply;
-    		delete networkManager;
+			delete networkManager;
 		}
 		else
 		{
-			QString file = QString::fromUtf8(source);
-
-			if (file.mid(0, 1)  == ":")
-				file = ":/effects/"+file.mid(1);
-
 			reader.setDecideFormatFromContent(true);
-			reader.setFileName(file);
+			reader.setFileName(key.source);
 		}
 	}
 	else
 	{
-		PyArg_ParseTuple(args, "|siiiip", &source, &cropLeft, &cropTop, &cropRight, &cropBottom, &grayscale);
-		buffer.setData(QByteArray::fromBase64(getEffect()->_imageData.toUtf8()));
+		buffer.setData(QByteArray::fromBase64(key.source.toUtf8()));
 		buffer.open(QBuffer::ReadOnly);
 		reader.setDecideFormatFromContent(true);
 		reader.setDevice(&buffer);
 	}
 
-	if (reader.canRead())
+	if (!reader.canRead())
 	{
-		PyObject *result = PyList_New(reader.imageCount());
+		PyErr_SetString(PyExc_TypeError, reader.errorString().toUtf8().constData());
+		return QSharedPointer<const AnimationCache::Animation>();
+	}
 
-		for (int i = 0; i < reader.imageCount(); ++i)
-		{
-			reader.jumpToImage(i);
-			if (reader.canRead())
-			{
-				QImage qimage = reader.read();
-				int width = qimage.width();
-				int height = qimage.height();
+	QSharedPointer<AnimationCache::Animation> animation(new AnimationCache::Animation);
+	animation->frames.reserve(reader.imageCount());
 
-				if (cropLeft > 0 || cropTop > 0 || cropRight > 0 || cropBottom > 0)
-				{
-					if (cropLeft + cropRight >= width || cropTop + cropBottom >= height)
-					{
-						QString errorStr = QString("Rejecting invalid crop values: left: %1, right: %2, top: %3, bottom: %4, higher than height/width %5/%6").arg(cropLeft).arg(cropRight).arg(cropTop).arg(cropBottom).arg(height).arg(width);
-						PyErr_SetString(PyExc_RuntimeError, qPrintable(errorStr));
-						return nullptr;
-					}
+	for (int i = 0; i < reader.imageCount(); ++i)
+	{
+		reader.jumpToImage(i);
+		if (!reader.canRead())
+		{
+			PyErr_SetString(PyExc_TypeError, reader.errorString().toUtf8().constData());
+			return QSharedPointer<const AnimationCache::Animation>();
+		}
 
-					qimage = qimage.copy(cropLeft, cropTop, width - cropLeft - cropRight, height - cropTop - cropBottom);
-					width = qimage.width();
-					height = qimage.height();
-				}
+		QImage qimage = reader.read();
+		if (qimage.depth() != 32)
+		{
+			qimage = qimage.convertToFormat(QImage::Format_ARGB32);
+		}
 
-				QByteArray binaryImage;
-				for (int i = 0; i<height; i++)
-				{
-					const QRgb *scanline = reinterpret_cast<const QRgb *>(qimage.scanLine(i));
-					const QRgb *end = scanline + qimage.width();
-					for (; scanline != end; scanline++)
-					{
-						binaryImage.append(!grayscale ? (char) qRed(scanline[0]) : (char) qGray(scanline[0]));
-						binaryImage.append(!grayscale ? (char) qGreen(scanline[1]) : (char) qGray(scanline[1]));
-						binaryImage.append(!grayscale ? (char) qBlue(scanline[2]) : (char) qGray(scanline[2]));
-					}
-				}
-				PyList_SET_ITEM(result, i, Py_BuildValue("{s:i,s:i,s:O}", "imageWidth", width, "imageHeight", height, "imageData", PyByteArray_FromStringAndSize(binaryImage.constData(),binaryImage.size())));
+		const QMargins& crop = key.crop;
+		if (crop.left() > 0 || crop.top() > 0 || crop.right() > 0 || crop.bottom() > 0)
+		{
+			const int width = qimage.width();
+			const int height = qimage.height();
+			if (crop.left() + crop.right() >= width || crop.top() + crop.bottom() >= height)
+			{
+				QString errorStr = QString("Rejecting invalid crop values: left: %1, right: %2, top: %3, bottom: %4, higher than height/width %5/%6").arg(crop.left()).arg(crop.right()).arg(crop.top()).arg(crop.bottom()).arg(height).arg(width);
+				PyErr_SetString(PyExc_RuntimeError, qPrintable(errorStr));
+				return QSharedPointer<const AnimationCache::Animation>();
 			}
-			else
+			qimage = qimage.copy(crop.left(), crop.top(), width - crop.left() - crop.right(), height - crop.top() - crop.bottom());
+		}
+
+		Image<ColorRgb> image = Effect::toRgbImage(qimage);
+		if (key.grayscale)
+		{
+			ColorRgb* pixel = image.memptr();
+			ColorRgb* end = pixel + image.width() * image.height();
+			for (; pixel != end; ++pixel)
 			{
-				PyErr_SetString(PyExc_TypeError, reader.errorString().toUtf8().constData());
-				return nullptr;
+				const uint8_t gray = static_cast<uint8_t>(qGray(pixel->red, pixel->green, pixel->blue));
+				pixel->red = pixel->green = pixel->blue = gray;
 			}
 		}
 
-		return result;
-	}
-	else
-	{
-		PyErr_SetString(PyExc_TypeError, reader.errorString().toUtf8().constData());
-		return nullptr;
+		animation->size += image.size();
+		animation->frames.append(image);
 	}
+
+	return animation;
 }
 
 PyObject* EffectModule::wrapAbort(PyObject *self, PyObject *)
@@ -343,6 +443,61 @@ PyObject* EffectModule::wrapAbort(PyObject *self, PyObject *)
 }
 
 
+PyObject* EffectModule::wrapWaitForNextFrame(PyObject *self, PyObject *args)
+{
+	// fps <= 0 follows the output rate of the smoothing, align snaps the frame interval to whole output intervals
+	double fps = 0.0;
+	int align = false;
+	if (!PyArg_ParseTuple(args, "|dp", &fps, &align))
+	{
+		return nullptr;
+	}
+
+	Effect* effect = getEffect();
+	const double outputRate = effect->_outputRate;
+	if (fps <= 0.0)
+	{
+		fps = (outputRate > 0.0) ? outputRate : DEFAULT_FPS;
+	}
+
+	qint64 interval = static_cast<qint64>(1e9 / fps);
+	if (align && outputRate > 0.0)
+	{
+		const qint64 outputInterval = static_cast<qint64>(1e9 / outputRate);
+		interval = qMax<qint64>(1, qRound64(static_cast<double>(interval) / outputInterval)) * outputInterval;
+	}
+
+	// the first call starts the monotonic frame clock
+	if (!effect->_frameTimer.isValid())
+	{
+		effect->_frameTimer.start();
+		effect->_frameDue = 0;
+	}
+
+	// deadlines are absolute, time spent rendering the frame doesn't add up to a drift
+	effect->_frameDue += interval;
+	qint64 remaining = effect->_frameDue - effect->_frameTimer.nsecsElapsed();
+
+	int missed = 0;
+	if (remaining < 0)
+	{
+		// too late, continue with the next deadline ahead instead of rushing to catch up
+		missed = static_cast<int>(1 + (-remaining) / interval);
+		effect->_frameDue += (missed - 1) * interval;
+		return Py_BuildValue("i", missed);
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	while (remaining > 0 && !effect->isInterruptionRequested())
+	{
+		QThread::usleep(static_cast<unsigned long>(qMin(remaining, MAX_FRAME_WAIT_NS) / 1000));
+		remaining = effect->_frameDue - effect->_frameTimer.nsecsElapsed();
+	}
+	Py_END_ALLOW_THREADS
+
+	return Py_BuildValue("i", missed);
+}
+
 PyObject* EffectModule::wrapImageShow(PyObject *self, PyObject *args)
 {
 	int argCount = PyTuple_Size(args);
@@ -353,32 +508,14 @@ PyObject* EffectModule::wrapImageShow(PyObject *self, PyObject *args)
 		argsOk = true;
 	}
 
-	if ( ! argsOk || (imgId>-1 && imgId >= getEffect()->_imageStack.size()))
+	Effect* effect = getEffect();
+	if ( ! argsOk || (imgId>-1 && imgId >= effect->_imageStack.size()))
 	{
 		return nullptr;
 	}
 
-
-	QImage * qimage = (imgId<0) ? &(getEffect()->_image) : &(getEffect()->_imageStack[imgId]);
-	int width = qimage->width();
-	int height = qimage->height();
-
-	Image<ColorRgb> image(width, height);
-	QByteArray binaryImage;
-
-	for (int i = 0; i<height; ++i)
-	{
-		const QRgb * scanline = reinterpret_cast<const QRgb *>(qimage->scanLine(i));
-		for (int j = 0; j< width; ++j)
-		{
-			binaryImage.append((char) qRed(scanline[j]));
-			binaryImage.append((char) qGreen(scanline[j]));
-			binaryImage.append((char) qBlue(scanline[j]));
-		}
-	}
-
-	memcpy(image.memptr(), binaryImage.data(), binaryImage.size());
-	emit getEffect()->setInputImage(getEffect()->_priority, image, getEffect()->getRemaining(), false);
+	const QImage& qimage = (imgId<0) ? effect->_image : effect->_imageStack[imgId];
+	emit effect->setInputImage(effect->_priority, Effect::toRgbImage(qimage), effect->getRemaining(), false);
 
 	return Py_BuildValue("");
 }
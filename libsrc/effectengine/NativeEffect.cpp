@@ -0,0 +1,202 @@
+// Qt includes
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QPainter>
+#include <QThread>
+
+// effect engine includes
+#include <effectengine/NativeEffect.h>
+#include <effectengine/Effect.h>
+#include <effectengine/EffectClipCache.h>
+#include <hyperion/Hyperion.h>
+#include <hyperion/ImageToLedsMap.h>
+#include <utils/Logger.h>
+
+/// Maximum time to sleep without checking for an interruption
+static const qint64 MAX_SLEEP_SLICE_US = 50000;
+
+void NativeEffect::run(Effect* effect)
+{
+	_effect = effect;
+
+	QMetaObject::invokeMethod(_effect->_hyperion, "getLedCount", Qt::BlockingQueuedConnection, Q_RETURN_ARG(int, _ledCount));
+	QMetaObject::invokeMethod(_effect->_hyperion, "getLatchTime", Qt::BlockingQueuedConnection, Q_RETURN_ARG(int, _latchTime));
+
+	loop();
+}
+
+bool NativeEffect::abort() const
+{
+	return _effect->isInterruptionRequested();
+}
+
+bool NativeEffect::sleep(double seconds)
+{
+	const qint64 duration = qint64(seconds * 1000000);
+	_timeSinceFrame += duration;
+
+	QElapsedTimer timer;
+	timer.start();
+	while (!abort())
+	{
+		const qint64 remaining = duration - timer.nsecsElapsed() / 1000;
+		if (remaining <= 0)
+		{
+			return true;
+		}
+		QThread::usleep(static_cast<unsigned long>(qMin(remaining, MAX_SLEEP_SLICE_US)));
+	}
+	return false;
+}
+
+void NativeEffect::setColor(const ColorRgb& color)
+{
+	setColors(std::vector<ColorRgb>(static_cast<size_t>(_ledCount), color));
+}
+
+void NativeEffect::setPeriodic(int warmupFrames, int periodFrames)
+{
+	if (!_effect->_clipEnabled || _frame > 0 || warmupFrames < 0 || periodFrames <= 0
+		|| !EffectClipCache::fits(qint64(periodFrames) * _ledCount * qint64(sizeof(ColorRgb))))
+	{
+		return;
+	}
+
+	_clip.reset(new EffectClip);
+	_clip->frames.reserve(periodFrames);
+	_clip->durations.reserve(periodFrames);
+	_clipStart = warmupFrames;
+	_clipEnd = warmupFrames + periodFrames;
+}
+
+void NativeEffect::recordFrame(const std::vector<ColorRgb>& ledColors)
+{
+	const int frame = _frame++;
+	if (!_clip.isNull() && frame >= _clipStart)
+	{
+		// the previous frame lasted until now
+		if (frame > _clipStart)
+		{
+			_clip->durations.last() = _timeSinceFrame;
+		}
+
+		if (frame < _clipEnd)
+		{
+			_clip->frames.append(ledColors);
+			_clip->durations.append(0);
+			_clip->size += qint64(ledColors.size() * sizeof(ColorRgb));
+		}
+		else
+		{
+			qint64 period = 0;
+			for (qint64 duration : qAsConst(_clip->durations))
+			{
+				period += duration;
+			}
+
+			// a clip without any delay can't be replayed
+			if (period > 0)
+			{
+				Debug(Logger::getInstance("EFFECTENGINE"), "Recorded clip of %s: %d frames, %d ms", QSTRING_CSTR(_effect->_script), _clip->frames.size(), static_cast<int>(period / 1000));
+				EffectClipCache::getInstance()->insert(_effect->_clipKey, _clip);
+			}
+			_clip.reset();
+			_clipMapping.reset();
+		}
+	}
+	_timeSinceFrame = 0;
+}
+
+void NativeEffect::setColors(const std::vector<ColorRgb>& ledColors)
+{
+	if (!_clip.isNull())
+	{
+		recordFrame(ledColors);
+	}
+	else
+	{
+		++_frame;
+	}
+	emit _effect->setInput(_effect->_priority, ledColors, _effect->getRemaining(), false);
+}
+
+void NativeEffect::setImage(const Image<ColorRgb>& image)
+{
+	if (!_clip.isNull())
+	{
+		if (_clipMapping.isNull() || _clipMapping->width() != image.width() || _clipMapping->height() != image.height())
+		{
+			_clipMapping.reset(new hyperion::ImageToLedsMap(image.width(), image.height(), 0, 0, _effect->_clipLeds));
+		}
+		recordFrame(_clipMapping->getMeanLedColor(image));
+	}
+	else
+	{
+		++_frame;
+	}
+	emit _effect->setInputImage(_effect->_priority, image, _effect->getRemaining(), false);
+}
+
+void NativeEffect::imageMinSize(int width, int height)
+{
+	const QSize& size = _effect->_imageSize;
+	if (size.width() < width || size.height() < height)
+	{
+		delete _effect->_painter;
+
+		_effect->_image = _effect->_image.scaled(qMax(size.width(), width), qMax(size.height(), height), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+		_effect->_imageSize = _effect->_image.size();
+		_effect->_painter = new QPainter(&(_effect->_image));
+	}
+}
+
+QSize NativeEffect::imageSize() const
+{
+	return _effect->_imageSize;
+}
+
+QPainter* NativeEffect::painter() const
+{
+	return _effect->_painter;
+}
+
+void NativeEffect::imageShow()
+{
+	setImage(Effect::toRgbImage(_effect->_image));
+}
+
+const QJsonObject& NativeEffect::args() const
+{
+	return _effect->_args;
+}
+
+double NativeEffect::argDouble(const QString& key, double defaultValue) const
+{
+	return args().value(key).toDouble(defaultValue);
+}
+
+int NativeEffect::argInt(const QString& key, int defaultValue) const
+{
+	const QJsonValue value = args().value(key);
+	return value.isDouble() ? static_cast<int>(value.toDouble()) : defaultValue;
+}
+
+bool NativeEffect::argBool(const QString& key, bool defaultValue) const
+{
+	const QJsonValue value = args().value(key);
+	if (value.isDouble())
+	{
+		return value.toDouble() != 0.0;
+	}
+	return value.toBool(defaultValue);
+}
+
+ColorRgb NativeEffect::argColor(const QString& key, const ColorRgb& defaultValue) const
+{
+	const QJsonArray color = args().value(key).toArray();
+	if (color.size() < 3)
+	{
+		return defaultValue;
+	}
+	return { static_cast<uint8_t>(color[0].toInt()), static_cast<uint8_t>(color[1].toInt()), static_cast<uint8_t>(color[2].toInt()) };
+}
@@ -0,0 +1,583 @@
+// Qt includes
+#include <QByteArray>
+#include <QConicalGradient>
+#include <QJsonArray>
+#include <QPainter>
+
+// effect engine includes
+#include <effectengine/NativeEffect.h>
+
+// STL includes
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+// Native implementations of the stock effect scripts.
+// Each class follows the Python script of the same name, including its argument defaults and timing.
+
+namespace {
+
+/// Round half to even like Python's round()
+int pyRound(double value)
+{
+	return static_cast<int>(std::nearbyint(value));
+}
+
+/// Greatest common divisor, used to determine the period of rotating effects
+int gcd(int a, int b)
+{
+	while (b != 0)
+	{
+		const int rest = a % b;
+		a = b;
+		b = rest;
+	}
+	return a;
+}
+
+/// colorsys.hsv_to_rgb()
+void hsvToRgb(double h, double s, double v, double& r, double& g, double& b)
+{
+	if (s == 0.0)
+	{
+		r = g = b = v;
+		return;
+	}
+	int i = static_cast<int>(h * 6.0);
+	const double f = (h * 6.0) - i;
+	const double p = v * (1.0 - s);
+	const double q = v * (1.0 - s * f);
+	const double t = v * (1.0 - s * (1.0 - f));
+	switch (i % 6)
+	{
+		case 0: r = v; g = t; b = p; break;
+		case 1: r = q; g = v; b = p; break;
+		case 2: r = p; g = v; b = t; break;
+		case 3: r = p; g = q; b = v; break;
+		case 4: r = t; g = p; b = v; break;
+		default: r = v; g = p; b = q; break;
+	}
+}
+
+///
+/// fade.py: Fade between two colors, optionally repeated
+///
+class FadeEffect : public NativeEffect
+{
+protected:
+	void loop() override
+	{
+		const double fadeInTime     = argDouble("fade-in-time", 2000) / 1000.0;
+		const double fadeOutTime    = argDouble("fade-out-time", 2000) / 1000.0;
+		const ColorRgb colorStart   = argColor("color-start", {255, 174, 11});
+		const ColorRgb colorEnd     = argColor("color-end", {0, 0, 0});
+		const double colorStartTime = argDouble("color-start-time", 1000) / 1000.0;
+		const double colorEndTime   = argDouble("color-end-time", 1000) / 1000.0;
+		const int repeat            = argInt("repeat-count", 0);
+		const bool maintainEndColor = argBool("maintain-end-color", true);
+		double minStepTime = latchTime() / 1000.0;
+		if (minStepTime == 0.0)
+		{
+			minStepTime = 0.001;
+		}
+
+		// create color table for fading from start to end color
+		const int start[3] = { colorStart.red, colorStart.green, colorStart.blue };
+		const int end[3]   = { colorEnd.red, colorEnd.green, colorEnd.blue };
+		double steps = std::max({ std::abs(end[0] - start[0]), std::abs(end[1] - start[1]), std::abs(end[2] - start[2]) });
+		double colorStep[3] = { 0.0, 0.0, 0.0 };
+		if (steps == 0.0)
+		{
+			steps = 1.0;
+		}
+		else
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				colorStep[i] = (end[i] - start[i]) / steps;
+			}
+		}
+
+		const int lastStep = static_cast<int>(steps);
+		std::vector<ColorRgb> colors;
+		colors.reserve(static_cast<size_t>(lastStep) + 1);
+		for (int step = 0; step <= lastStep; ++step)
+		{
+			uint8_t channel[3];
+			for (int i = 0; i < 3; ++i)
+			{
+				channel[i] = static_cast<uint8_t>(std::min(std::max(pyRound(start[i] + colorStep[i] * step), 0), start[i] < end[i] ? end[i] : start[i]));
+			}
+			colors.push_back({ channel[0], channel[1], channel[2] });
+		}
+
+		// calculate timings
+		int incrementIn = 1, incrementOut = 1;
+		double sleepTimeIn = 1.0, sleepTimeOut = 1.0;
+		if (fadeInTime > 0)
+		{
+			incrementIn = std::max(1, pyRound(steps / (fadeInTime / minStepTime)));
+			sleepTimeIn = fadeInTime / (steps / incrementIn);
+		}
+		if (fadeOutTime > 0)
+		{
+			incrementOut = std::max(1, pyRound(steps / (fadeOutTime / minStepTime)));
+			sleepTimeOut = fadeOutTime / (steps / incrementOut);
+		}
+
+		// the script repeats the hold color every minStepTime until the hold time has passed
+		const double holdStartTime = std::ceil(colorStartTime / minStepTime) * minStepTime;
+		const double holdEndTime = std::ceil(colorEndTime / minStepTime) * minStepTime;
+
+		int repeatCounter = 1;
+		while (!abort())
+		{
+			// fade in
+			if (fadeInTime > 0)
+			{
+				setFadeColor(colors[0]);
+				for (int step = 0; step <= lastStep; step += incrementIn)
+				{
+					if (abort()) break;
+					setFadeColor(colors[step]);
+					sleep(sleepTimeIn);
+				}
+			}
+
+			// end color
+			if (holdStartTime > 0 && !abort())
+			{
+				setFadeColor(colors[lastStep]);
+				sleep(holdStartTime);
+			}
+
+			// fade out
+			if (fadeOutTime > 0)
+			{
+				setFadeColor(colors[lastStep]);
+				for (int step = lastStep; step >= 0; step -= incrementOut)
+				{
+					if (abort()) break;
+					setFadeColor(colors[step]);
+					sleep(sleepTimeOut);
+				}
+			}
+
+			// start color
+			if (holdEndTime > 0 && !abort())
+			{
+				setFadeColor(colors[0]);
+				sleep(holdEndTime);
+			}
+
+			// repeat
+			if (repeat > 0 && repeatCounter >= repeat) break;
+			++repeatCounter;
+		}
+
+		sleep(0.5);
+
+		// maintain end color until effect end
+		while (!abort() && maintainEndColor)
+		{
+			setColor(_current);
+			sleep(1.0);
+		}
+	}
+
+private:
+	void setFadeColor(const ColorRgb& color)
+	{
+		_current = color;
+		setColor(color);
+	}
+
+	ColorRgb _current = ColorRgb::BLACK;
+};
+
+///
+/// knight-rider.py: A fading dot running back and forth
+///
+class KnightRiderEffect : public NativeEffect
+{
+protected:
+	void loop() override
+	{
+		const double speed = std::max(0.0001, argDouble("speed", 1.0));
+		const double fadeFactor = std::max(0.0, std::min(argDouble("fadeFactor", 0.7), 1.0));
+		const ColorRgb color = argColor("color", {255, 0, 0});
+
+		// Initialize the led data
+		const int width = 25;
+		Image<ColorRgb> image(width, 1, ColorRgb::BLACK);
+		image(0, 0) = color;
+
+		// Calculate the sleep time and rotation increment
+		int increment = 1;
+		double sleepTime = 1.0 / (speed * width);
+		while (sleepTime < 0.05)
+		{
+			increment *= 2;
+			sleepTime *= 2;
+		}
+
+		// the dot returns to its start after each back and forth run, older trails are faded out to black
+		// after at most 255 moves as each fade reduces a color channel
+		const int run = 2 * (width - 1);
+		setPeriodic((255 + increment - 1) / increment + 1, run / gcd(run, increment % run));
+
+		int position = 0;
+		int direction = 1;
+		while (!abort())
+		{
+			setImage(image);
+
+			// Move data into next state
+			for (int i = 0; i < increment; ++i)
+			{
+				position += direction;
+				if (position == -1)
+				{
+					position = 1;
+					direction = 1;
+				}
+				else if (position == width)
+				{
+					position = width - 2;
+					direction = -1;
+				}
+
+				// Fade the old data
+				for (int j = 0; j < width; ++j)
+				{
+					ColorRgb& pixel = image(j, 0);
+					pixel.red   = static_cast<uint8_t>(fadeFactor * pixel.red);
+					pixel.green = static_cast<uint8_t>(fadeFactor * pixel.green);
+					pixel.blue  = static_cast<uint8_t>(fadeFactor * pixel.blue);
+				}
+
+				// Insert new data
+				image(position, 0) = color;
+			}
+
+			sleep(sleepTime);
+		}
+	}
+};
+
+///
+/// rainbow-mood.py: All leds cycle through the hue circle
+///
+class RainbowMoodEffect : public NativeEffect
+{
+protected:
+	void loop() override
+	{
+		const double rotationTime = argDouble("rotation-time", 30.0);
+		const double brightness   = argDouble("brightness", 100) / 100.0;
+		const double saturation   = argDouble("saturation", 100) / 100.0;
+		const bool reverse        = argBool("reverse", false);
+
+		// Calculate the sleep time and hue increment
+		const double sleepTime = 0.1;
+		double hueIncrement = sleepTime / std::max(sleepTime, rotationTime);
+
+		// Switch direction if needed
+		if (reverse)
+		{
+			hueIncrement = -hueIncrement;
+		}
+
+		// periodic if the hue circle is split into whole steps
+		const double steps = 1.0 / std::abs(hueIncrement);
+		if (std::abs(steps - std::round(steps)) < 1e-9)
+		{
+			setPeriodic(0, static_cast<int>(std::round(steps)));
+		}
+
+		double hue = 0.0;
+		while (!abort())
+		{
+			double r, g, b;
+			hsvToRgb(hue, saturation, brightness, r, g, b);
+			setColor({ static_cast<uint8_t>(255 * r), static_cast<uint8_t>(255 * g), static_cast<uint8_t>(255 * b) });
+			hue = std::fmod(hue + hueIncrement, 1.0);
+			if (hue < 0.0)
+			{
+				hue += 1.0;
+			}
+			sleep(sleepTime);
+		}
+	}
+};
+
+///
+/// police.py: Two rotating color blocks
+///
+class PoliceEffect : public NativeEffect
+{
+protected:
+	void loop() override
+	{
+		const int count = ledCount();
+		if (count <= 0)
+		{
+			return;
+		}
+
+		double rotationTime      = argDouble("rotation-time", 2.0);
+		const ColorRgb colorOne  = argColor("color_one", {255, 0, 0});
+		const ColorRgb colorTwo  = argColor("color_two", {0, 0, 255});
+		double colorsCount       = argDouble("colors_count", count / 2.0);
+		const bool reverse       = argBool("reverse", false);
+
+		// Check parameters
+		rotationTime = std::max(0.1, rotationTime);
+		colorsCount = std::min(count / 2.0, colorsCount);
+
+		// Initialize the led data
+		std::vector<uint8_t> ledData;
+		ledData.reserve(3 * static_cast<size_t>(count));
+		for (int i = 0; i < count; ++i)
+		{
+			ColorRgb color = ColorRgb::BLACK;
+			if (i <= colorsCount)
+			{
+				color = colorOne;
+			}
+			else if (i >= count / 2.0 - 1 && i < count / 2.0 + colorsCount)
+			{
+				color = colorTwo;
+			}
+			ledData.push_back(color.red);
+			ledData.push_back(color.green);
+			ledData.push_back(color.blue);
+		}
+
+		// Calculate the sleep time and rotation increment, the script rotates the bytes of the led data
+		int increment = 3;
+		double sleepTime = rotationTime / count;
+		while (sleepTime < 0.05)
+		{
+			increment *= 2;
+			sleepTime *= 2;
+		}
+		increment %= count;
+
+		// Switch direction if needed
+		if (reverse)
+		{
+			increment = -increment;
+		}
+
+		const int size = static_cast<int>(ledData.size());
+		const int shift = ((increment % size) + size) % size;
+		setPeriodic(0, size / gcd(size, shift));
+
+		std::vector<ColorRgb> ledColors(static_cast<size_t>(count));
+		while (!abort())
+		{
+			std::copy(ledData.begin(), ledData.end(), reinterpret_cast<uint8_t*>(ledColors.data()));
+			setColors(ledColors);
+			std::rotate(ledData.begin(), ledData.begin() + (size - shift), ledData.end());
+			sleep(sleepTime);
+		}
+	}
+};
+
+///
+/// swirl.py: One or two rotating conical gradients
+///
+class SwirlEffect : public NativeEffect
+{
+protected:
+	void loop() override
+	{
+		// set minimum image size - must be done asap
+		imageMinSize(64, 64);
+		const QSize size = imageSize();
+
+		// Get the parameters
+		const double rotationTime  = argDouble("rotation-time", 10.0);
+		const bool reverse         = argBool("reverse", false);
+		const double centerX       = argDouble("center_x", 0.5);
+		const double centerY       = argDouble("center_y", 0.5);
+		const bool randomCenter    = argBool("random-center", false);
+		const bool enableSecond    = argBool("enable-second", false);
+		const bool reverse2        = argBool("reverse2", true);
+		const double centerX2      = argDouble("center_x2", 0.5);
+		const double centerY2      = argDouble("center_y2", 0.5);
+		const bool randomCenter2   = argBool("random-center2", false);
+
+		QJsonArray custColors = { QJsonArray{255,0,0}, QJsonArray{0,255,0}, QJsonArray{0,0,255} };
+		if (args().contains("custom-colors"))
+		{
+			custColors = args().value("custom-colors").toArray();
+		}
+
+		QJsonArray custColors2 = {
+			QJsonArray{255,255,255,0}, QJsonArray{0,255,255,0}, QJsonArray{255,255,255,1}, QJsonArray{0,255,255,0},
+			QJsonArray{0,255,255,0},   QJsonArray{0,255,255,0}, QJsonArray{255,255,255,1}, QJsonArray{0,255,255,0},
+			QJsonArray{0,255,255,0},   QJsonArray{0,255,255,0}, QJsonArray{255,255,255,1}, QJsonArray{0,255,255,0}
+		};
+		if (args().contains("custom-colors2"))
+		{
+			custColors2 = args().value("custom-colors2").toArray();
+		}
+
+		// process parameters
+		const QPoint pointS1 = getPoint(size, randomCenter, centerX, centerY);
+		const QPoint pointS2 = getPoint(size, randomCenter2, centerX2, centerY2);
+
+		double sleepTime = std::max(0.1, rotationTime) / 360;
+		double minStepTime = latchTime() / 1000.0;
+		if (minStepTime == 0.0)
+		{
+			minStepTime = 0.001;
+		}
+		sleepTime = std::max(sleepTime, minStepTime);
+
+		const int increment  = reverse ? -1 : 1;
+		const int increment2 = reverse2 ? -1 : 1;
+
+		QByteArray baS1;
+		if (custColors.size() > 1)
+		{
+			baS1 = buildGradient(custColors);
+		}
+		else
+		{
+			const uint8_t defaultGradient[] = {
+				0  ,255,0  ,0  , 255,
+				25 ,255,230,0  , 255,
+				63 ,255,255,0  , 255,
+				100,0  ,255,0  , 255,
+				127,0  ,255,200, 255,
+				159,0  ,255,255, 255,
+				191,0  ,0  ,255, 255,
+				224,255,0  ,255, 255,
+				255,255,0  ,127, 255,
+			};
+			baS1 = QByteArray(reinterpret_cast<const char*>(defaultGradient), sizeof(defaultGradient));
+		}
+
+		// check if the second swirl should be build
+		const bool S2 = enableSecond && custColors2.size() > 1;
+		const QByteArray baS2 = S2 ? buildGradient(custColors2) : QByteArray();
+
+		// both swirls run through all 361 angles, random centers differ on each start
+		if (!randomCenter && !(S2 && randomCenter2))
+		{
+			setPeriodic(0, 361);
+		}
+
+		int angle = 0;
+		int angle2 = 0;
+		while (!abort())
+		{
+			angle = rotate(angle, increment);
+			angle2 = rotate(angle2, increment2);
+
+			conicalGradient(size, pointS1, angle, baS1);
+			if (S2)
+			{
+				conicalGradient(size, pointS2, angle2, baS2);
+			}
+
+			imageShow();
+			sleep(sleepTime);
+		}
+	}
+
+private:
+	static int rotate(int angle, int increment)
+	{
+		angle += increment;
+		if (angle > 360) angle = 0;
+		if (angle < 0) angle = 360;
+		return angle;
+	}
+
+	QPoint getPoint(const QSize& size, bool random, double x, double y)
+	{
+		if (random)
+		{
+			std::uniform_real_distribution<double> distribution(0.0, 1.0);
+			x = distribution(_random);
+			y = distribution(_random);
+		}
+		return QPoint(pyRound(x * size.width()), pyRound(y * size.height()));
+	}
+
+	/// Gradient stops of 5 bytes each (position, red, green, blue, alpha) like the script's bytearray
+	static QByteArray buildGradient(const QJsonArray& colors, bool closeCircle = true)
+	{
+		QByteArray gradient;
+		const int posfac = 255 / colors.size();
+		const bool withAlpha = colors.at(0).toArray().size() == 4;
+		int pos = 0;
+
+		auto appendStop = [&gradient, withAlpha](int position, const QJsonArray& color)
+		{
+			const int alpha = withAlpha ? static_cast<int>(color.at(3).toDouble() * 255) : 255;
+			gradient.append(static_cast<char>(position));
+			gradient.append(static_cast<char>(color.at(0).toInt()));
+			gradient.append(static_cast<char>(color.at(1).toInt()));
+			gradient.append(static_cast<char>(color.at(2).toInt()));
+			gradient.append(static_cast<char>(alpha));
+		};
+
+		for (const QJsonValue& color : colors)
+		{
+			pos += posfac;
+			appendStop(pos, color.toArray());
+		}
+
+		// last color as first color
+		if (closeCircle)
+		{
+			appendStop(0, colors.last().toArray());
+		}
+		return gradient;
+	}
+
+	void conicalGradient(const QSize& size, const QPoint& center, int angle, const QByteArray& stops)
+	{
+		QConicalGradient gradient(center, qMax(qMin(angle, 360), 0));
+		const uint8_t* data = reinterpret_cast<const uint8_t*>(stops.constData());
+		for (int idx = 0; idx + 4 < stops.size(); idx += 5)
+		{
+			gradient.setColorAt(data[idx] / 255.0, QColor(data[idx+1], data[idx+2], data[idx+3], data[idx+4]));
+		}
+		painter()->fillRect(QRect(QPoint(0, 0), size), gradient);
+	}
+
+	std::mt19937 _random { std::random_device()() };
+};
+
+} // namespace
+
+NativeEffect* NativeEffect::create(const QString& script)
+{
+	// only the built-in scripts are replaced, custom scripts may differ from them
+	const QString builtinPath = ":/effects/";
+	if (!script.startsWith(builtinPath))
+	{
+		return nullptr;
+	}
+
+	const QString name = script.mid(builtinPath.length());
+	if (name == "fade.py")
+		return new FadeEffect();
+	if (name == "knight-rider.py")
+		return new KnightRiderEffect();
+	if (name == "rainbow-mood.py")
+		return new RainbowMoodEffect();
+	if (name == "police.py")
+		return new PoliceEffect();
+	if (name == "swirl.py")
+		return new SwirlEffect();
+
+	return nullptr;
+}
@@ -6,6 +6,8 @@
 #include <QTimer>
 #include <QRgb>
 
+#include <utils/Metrics.h>
+
 FlatBufferClient::FlatBufferClient(QTcpSocket* socket, int timeout, QObject *parent)
 	: QObject(parent)
 	, _log(Logger::getInstance("FLATBUFSERVER"))
@@ -14,6 +16,7 @@ FlatBufferClient::FlatBufferClient(QTcpSocket* socket, int timeout, QObject *par
 	, _timeoutTimer(new QTimer(this))
 	, _timeout(timeout * 1000)
 	, _priority()
+	, _replyEnabled(true)
 {
 	// timer setup
 	_timeoutTimer->setSingleShot(true);
@@ -29,25 +32,14 @@ void FlatBufferClient::readyRead()
 {
 	_timeoutTimer->start();
 
-	_receiveBuffer += _socket->readAll();
+	_receiveBuffer.readFrom(_socket);
 
-	// check if we can read a header
-	while(_receiveBuffer.size() >= 4)
+	// messages are verified and handled in place
+	const uint8_t* msgData;
+	uint32_t messageSize;
+	ReceiveBuffer::Result result;
+	while ((result = _receiveBuffer.nextMessage(msgData, messageSize)) == ReceiveBuffer::Result::Message)
 	{
-		uint32_t messageSize =
-			((_receiveBuffer[0]<<24) & 0xFF000000) |
-			((_receiveBuffer[1]<<16) & 0x00FF0000) |
-			((_receiveBuffer[2]<< 8) & 0x0000FF00) |
-			((_receiveBuffer[3]    ) & 0x000000FF);
-
-		// check if we can read a complete message
-		if((uint32_t) _receiveBuffer.size() < messageSize + 4) return;
-
-		// extract message only and remove header + msg from buffer :: QByteArray::remove() does not return the removed data
-		const QByteArray msg = _receiveBuffer.mid(4, messageSize);
-		_receiveBuffer.remove(0, messageSize + 4);
-
-		const auto* msgData = reinterpret_cast<const uint8_t*>(msg.constData());
 		flatbuffers::Verifier verifier(msgData, messageSize);
 
 		if (hyperionnet::VerifyRequestBuffer(verifier))
@@ -58,6 +50,40 @@ void FlatBufferClient::readyRead()
 		}
 		sendErrorReply("Unable to parse message");
 	}
+
+	if (result == ReceiveBuffer::Result::Invalid)
+	{
+		Error(_log, "Invalid message size received from client %s", QSTRING_CSTR(_clientAddress));
+		_receiveBuffer.clear();
+		forceClose();
+	}
+}
+
+void FlatBufferClient::handleDatagram(const QByteArray& message)
+{
+	const auto* msgData = reinterpret_cast<const uint8_t*>(message.constData());
+	flatbuffers::Verifier verifier(msgData, static_cast<size_t>(message.size()));
+	if (!hyperionnet::VerifyRequestBuffer(verifier))
+	{
+		Debug(_log, "Unable to parse datagram message from client %s", QSTRING_CSTR(_clientAddress));
+		return;
+	}
+
+	const auto* request = hyperionnet::GetRequest(msgData);
+	if (request->command_as_Register() != nullptr)
+		return;
+
+	// datagrams keep the connection alive
+	_timeoutTimer->start();
+
+	_replyEnabled = false;
+	handleMessage(request);
+	_replyEnabled = true;
+}
+
+QHostAddress FlatBufferClient::getPeerAddress() const
+{
+	return _socket->peerAddress();
 }
 
 void FlatBufferClient::forceClose()
@@ -152,7 +178,7 @@ void FlatBufferClient::handleImageCommand(const hyperionnet::Image *image)
 		const int width = img->width();
 		const int height = img->height();
 
-		if (width <= 0 || height <= 0)
+		if (width <= 0 || height <= 0 || imageData == nullptr)
 		{
 			sendErrorReply("Size of image data does not match with the width and height");
 			return;
@@ -166,18 +192,23 @@ void FlatBufferClient::handleImageCommand(const hyperionnet::Image *image)
 			return;
 		}
 
-		// create ImageRgb
-		Image<ColorRgb> imageRGB(width, height);
-		if (channelCount == 3)
+		// decode into a pooled image, no allocation once receivers released the previous frames
+		Image<ColorRgb>& imageRGB = _imagePool.acquire(width, height);
 		{
-			memmove(imageRGB.memptr(), imageData->data(), imageData->size());
-		}
+			Metrics::ScopedTimer timer(Metrics::DECODE);
+			if (channelCount == 3)
+			{
+				memcpy(imageRGB.memptr(), imageData->data(), static_cast<size_t>(width) * height * sizeof(ColorRgb));
+			}
 
-		if (channelCount == 4)
-		{
-			for (int source=0, destination=0; source < width * height * static_cast<int>(sizeof(ColorRgb)); source+=sizeof(ColorRgb), destination+=sizeof(ColorRgba))
+			if (channelCount == 4)
 			{
-				memmove((uint8_t*)imageRGB.memptr() + source, imageData->data() + destination, sizeof(ColorRgb));
+				const uint8_t* source = imageData->data();
+				ColorRgb* destination = imageRGB.memptr();
+				for (int pixel = 0; pixel < width * height; ++pixel, source += sizeof(ColorRgba))
+				{
+					destination[pixel] = ColorRgb{ source[0], source[1], source[2] };
+				}
 			}
 		}
 
@@ -211,6 +242,9 @@ void FlatBufferClient::handleNotImplemented()
 
 void FlatBufferClient::sendMessage()
 {
+	if (!_replyEnabled)
+		return;
+
 	auto size = _builder.GetSize();
 	const uint8_t* buffer = _builder.GetBufferPointer();
 	uint8_t sizeData[] = {uint8_t(size >> 24), uint8_t(size >> 16), uint8_t(size >> 8), uint8_t(size)};
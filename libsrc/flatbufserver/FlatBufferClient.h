@@ -6,6 +6,8 @@
 #include <utils/ColorRgb.h>
 #include <utils/ColorRgba.h>
 #include <utils/Components.h>
+#include <utils/ImagePool.h>
+#include <utils/ReceiveBuffer.h>
 
 // flatbuffer FBS
 #include "hyperion_reply_generated.h"
@@ -13,6 +15,7 @@
 
 class QTcpSocket;
 class QTimer;
+class QHostAddress;
 
 namespace flatbuf {
 	class HyperionRequest;
@@ -33,6 +36,18 @@ public:
 	///
 	explicit FlatBufferClient(QTcpSocket* socket, int timeout, QObject *parent = nullptr);
 
+	///
+	/// @brief Handle a request received over UDP. Registration is only accepted over TCP and no replies are sent.
+	/// @param message The serialized request
+	///
+	void handleDatagram(const QByteArray& message);
+
+	/// @return The registered priority
+	int getPriority() const { return _priority; }
+
+	/// @return The address of the client
+	QHostAddress getPeerAddress() const;
+
 signals:
 	///
 	/// @brief forward register data to HyperionDaemon
@@ -141,7 +156,13 @@ private:
 	int _timeout;
 	int _priority;
 
-	QByteArray _receiveBuffer;
+	ReceiveBuffer _receiveBuffer;
+
+	/// Images the received frames are decoded to
+	ImagePool<ColorRgb> _imagePool;
+
+	/// Replies are not sent for requests received over UDP
+	bool _replyEnabled;
 
 	// Flatbuffers builder
 	flatbuffers::FlatBufferBuilder _builder;
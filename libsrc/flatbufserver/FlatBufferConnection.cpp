@@ -3,14 +3,21 @@
 
 // Qt includes
 #include <QRgb>
+#include <QUdpSocket>
 
 // flatbuffer includes
 #include <flatbufserver/FlatBufferConnection.h>
+#include <flatbufserver/FlatBufferDatagram.h>
 
 // flatbuffer FBS
 #include "hyperion_reply_generated.h"
 #include "hyperion_request_generated.h"
 
+namespace {
+// frames are held back while more data than this is waiting in the socket buffer
+const qint64 IN_FLIGHT_BUDGET = 256 * 1024;
+}
+
 FlatBufferConnection::FlatBufferConnection(const QString& origin, const QString& host, int priority, bool skipReply, quint16 port)
 	: _socket()
 	, _origin(origin)
@@ -20,10 +27,17 @@ FlatBufferConnection::FlatBufferConnection(const QString& origin, const QString&
 	, _prevSocketState(QAbstractSocket::UnconnectedState)
 	, _log(Logger::getInstance("FLATBUFCONN"))
 	, _registered(false)
+	, _droppedFrames(0)
+	, _dropping(false)
+	, _udpSocket(nullptr)
+	, _sequence(0)
+	, _udpOversized(false)
 {
 	if(!skipReply)
 		connect(&_socket, &QTcpSocket::readyRead, this, &FlatBufferConnection::readData, Qt::UniqueConnection);
 
+	connect(&_socket, &QTcpSocket::bytesWritten, this, &FlatBufferConnection::writePendingFrame);
+
 	// init connect
 	Info(_log, "Connecting to Hyperion: %s:%u", QSTRING_CSTR(_host), _port);
 	connectToHost();
@@ -81,6 +95,45 @@ void FlatBufferConnection::setSkipReply(bool skip)
 		connect(&_socket, &QTcpSocket::readyRead, this, &FlatBufferConnection::readData, Qt::UniqueConnection);
 }
 
+void FlatBufferConnection::setUdpTransport(bool enable)
+{
+	if (enable && _udpSocket == nullptr)
+	{
+		Info(_log, "Sending images over UDP to Hyperion: %s:%u, images larger than %d bytes are sent over TCP", QSTRING_CSTR(_host), _port, FlatBufferDatagram::MAX_MESSAGE_SIZE);
+		_udpSocket = new QUdpSocket(this);
+		_udpOversized = false;
+	}
+	else if (!enable && _udpSocket != nullptr)
+	{
+		delete _udpSocket;
+		_udpSocket = nullptr;
+	}
+}
+
+bool FlatBufferConnection::sendDatagrams(const char* data, int size)
+{
+	if (size > FlatBufferDatagram::MAX_MESSAGE_SIZE)
+	{
+		// reported once, the size of a grabber's images does not change
+		if (!_udpOversized)
+		{
+			Warning(_log, "Message of %d bytes is too large for the UDP transport (max. %d bytes), sending it over TCP", size, FlatBufferDatagram::MAX_MESSAGE_SIZE);
+			_udpOversized = true;
+		}
+		return false;
+	}
+
+	const QVector<QByteArray> datagrams = FlatBufferDatagram::fragment(data, size, static_cast<quint8>(_priority), _sequence++);
+
+	// the host name has been resolved by the TCP connection
+	const QHostAddress address = _socket.peerAddress();
+	for (const QByteArray& datagram : datagrams)
+	{
+		_udpSocket->writeDatagram(datagram, address, _port);
+	}
+	return true;
+}
+
 void FlatBufferConnection::setRegister(const QString& origin, int priority)
 {
 	auto registerReq = hyperionnet::CreateRegister(_builder, _builder.CreateString(QSTRING_CSTR(origin)), priority);
@@ -104,28 +157,105 @@ void FlatBufferConnection::setRegister(const QString& origin, int priority)
 
 void FlatBufferConnection::setColor(const ColorRgb & color, int priority, int duration)
 {
+	// a held back image must not replace the color
+	_pendingFrame.clear();
+
+	// check before building, the registration uses the builder
+	if (_udpSocket != nullptr && !isReadyToSend())
+		return;
+
 	auto colorReq = hyperionnet::CreateColor(_builder, (color.red << 16) | (color.green << 8) | color.blue, duration);
 	auto req = hyperionnet::CreateRequest(_builder, hyperionnet::Command_Color, colorReq.Union());
 
 	_builder.Finish(req);
-	sendMessage(_builder.GetBufferPointer(), _builder.GetSize());
+	if (_udpSocket == nullptr || !sendDatagrams(reinterpret_cast<const char *>(_builder.GetBufferPointer()), static_cast<int>(_builder.GetSize())))
+		sendMessage(_builder.GetBufferPointer(), _builder.GetSize());
 	_builder.Clear();
 }
 
 void FlatBufferConnection::setImage(const Image<ColorRgb> &image)
 {
-	auto imgData = _builder.CreateVector(reinterpret_cast<const uint8_t*>(image.memptr()), image.size());
-	auto rawImg = hyperionnet::CreateRawImage(_builder, imgData, image.width(), image.height());
-	auto imageReq = hyperionnet::CreateImage(_builder, hyperionnet::ImageType_RawImage, rawImg.Union(), -1);
-	auto req = hyperionnet::CreateRequest(_builder,hyperionnet::Command_Image,imageReq.Union());
+	sendImage(encodeImage(image));
+}
 
-	_builder.Finish(req);
-	sendMessage(_builder.GetBufferPointer(), _builder.GetSize());
-	_builder.Clear();
+QByteArray FlatBufferConnection::encodeImage(const Image<ColorRgb> &image)
+{
+	flatbuffers::FlatBufferBuilder builder(image.size() + 128);
+	auto imgData = builder.CreateVector(reinterpret_cast<const uint8_t*>(image.memptr()), image.size());
+	auto rawImg = hyperionnet::CreateRawImage(builder, imgData, image.width(), image.height());
+	auto imageReq = hyperionnet::CreateImage(builder, hyperionnet::ImageType_RawImage, rawImg.Union(), -1);
+	auto req = hyperionnet::CreateRequest(builder,hyperionnet::Command_Image,imageReq.Union());
+	builder.Finish(req);
+
+	const uint32_t size = builder.GetSize();
+	const char header[] = {
+		char((size >> 24) & 0xFF),
+		char((size >> 16) & 0xFF),
+		char((size >>  8) & 0xFF),
+		char((size	  ) & 0xFF)};
+
+	QByteArray message;
+	message.reserve(static_cast<int>(size) + 4);
+	message.append(header, 4);
+	message.append(reinterpret_cast<const char *>(builder.GetBufferPointer()), static_cast<int>(size));
+	return message;
+}
+
+void FlatBufferConnection::sendImage(const QByteArray &message)
+{
+	if (!isReadyToSend())
+	{
+		_pendingFrame.clear();
+		return;
+	}
+
+	// datagrams are not queued, lost or late ones are dropped by the receiver; images too large for them take the TCP path
+	if (_udpSocket != nullptr && sendDatagrams(message.constData() + 4, message.size() - 4))
+	{
+		return;
+	}
+
+	// latest frame wins, the receiver gets the most recent image as soon as the connection catches up
+	if (_socket.bytesToWrite() >= IN_FLIGHT_BUDGET)
+	{
+		if (!_pendingFrame.isEmpty())
+		{
+			++_droppedFrames;
+			if (!_dropping)
+			{
+				Debug(_log, "Hyperion %s:%u does not keep up, dropping frames", QSTRING_CSTR(_host), _port);
+				_dropping = true;
+			}
+		}
+		_pendingFrame = message;
+		return;
+	}
+
+	if (_socket.bytesToWrite() == 0 && _dropping)
+	{
+		Debug(_log, "Hyperion %s:%u keeps up again, %llu frames dropped so far", QSTRING_CSTR(_host), _port, static_cast<unsigned long long>(_droppedFrames));
+		_dropping = false;
+	}
+
+	_socket.write(message);
+	_socket.flush();
+}
+
+void FlatBufferConnection::writePendingFrame()
+{
+	if (!_pendingFrame.isEmpty() && _socket.bytesToWrite() < IN_FLIGHT_BUDGET)
+	{
+		const QByteArray message = _pendingFrame;
+		_pendingFrame.clear();
+		sendImage(message);
+	}
 }
 
 void FlatBufferConnection::clear(int priority)
 {
+	// a held back image must not reappear after the clear
+	_pendingFrame.clear();
+
 	auto clearReq = hyperionnet::CreateClear(_builder, priority);
 	auto req = hyperionnet::CreateRequest(_builder,hyperionnet::Command_Clear, clearReq.Union());
 
@@ -146,7 +276,7 @@ void FlatBufferConnection::connectToHost()
 	   _socket.connectToHost(_host, _port);
 }
 
-void FlatBufferConnection::sendMessage(const uint8_t* buffer, uint32_t size)
+bool FlatBufferConnection::isReadyToSend()
 {
 	// print out connection message only when state is changed
 	if (_socket.state() != _prevSocketState )
@@ -169,14 +299,22 @@ void FlatBufferConnection::sendMessage(const uint8_t* buffer, uint32_t size)
 
 
 	if (_socket.state() != QAbstractSocket::ConnectedState)
-		return;
+		return false;
 
 	if(!_registered)
 	{
 		setRegister(_origin, _priority);
-		return;
+		return false;
 	}
 
+	return true;
+}
+
+void FlatBufferConnection::sendMessage(const uint8_t* buffer, uint32_t size)
+{
+	if (!isReadyToSend())
+		return;
+
 	const uint8_t header[] = {
 		uint8_t((size >> 24) & 0xFF),
 		uint8_t((size >> 16) & 0xFF),
@@ -15,12 +15,29 @@
 #include <QJsonObject>
 #include <QTcpServer>
 #include <QTcpSocket>
+#include <QUdpSocket>
+
+namespace {
+// a burst of image fragments must fit into the socket buffer
+const int UDP_RECEIVE_BUFFER_SIZE = 2 * 1024 * 1024;
+
+// clients registered over TCP send datagrams from the same host, IPv4 addresses may be mapped to IPv6
+bool isSameHost(const QHostAddress& a, const QHostAddress& b)
+{
+	bool isIPv4a = false, isIPv4b = false;
+	const quint32 ipv4a = a.toIPv4Address(&isIPv4a);
+	const quint32 ipv4b = b.toIPv4Address(&isIPv4b);
+	return (isIPv4a && isIPv4b) ? ipv4a == ipv4b : a == b;
+}
+}
 
 FlatBufferServer::FlatBufferServer(const QJsonDocument& config, QObject* parent)
 	: QObject(parent)
 	, _server(new QTcpServer(this))
+	, _udpServer(new QUdpSocket(this))
 	, _log(Logger::getInstance("FLATBUFSERVER"))
 	, _timeout(5000)
+	, _udpEnabled(false)
 	, _config(config)
 {
 
@@ -36,6 +53,7 @@ void FlatBufferServer::initServer()
 {
 	_netOrigin = NetOrigin::getInstance();
 	connect(_server, &QTcpServer::newConnection, this, &FlatBufferServer::newConnection);
+	connect(_udpServer, &QUdpSocket::readyRead, this, &FlatBufferServer::readPendingDatagrams);
 
 	// apply config
 	handleSettingsUpdate(settings::FLATBUFSERVER, _config);
@@ -49,11 +67,13 @@ void FlatBufferServer::handleSettingsUpdate(settings::type type, const QJsonDocu
 
 		quint16 port = obj["port"].toInt(19400);
 
-		// port check
-		if(_server->serverPort() != port)
+		// port or transport check
+		const bool udpEnabled = obj["udp"].toBool(false);
+		if(_server->serverPort() != port || _udpEnabled != udpEnabled)
 		{
 			stopServer();
 			_port = port;
+			_udpEnabled = udpEnabled;
 		}
 
 		// new timeout just for new connections
@@ -93,6 +113,40 @@ void FlatBufferServer::clientDisconnected()
 	FlatBufferClient* client = qobject_cast<FlatBufferClient*>(sender());
 	client->deleteLater();
 	_openConnections.removeAll(client);
+	_reassemblers.remove(client);
+}
+
+void FlatBufferServer::readPendingDatagrams()
+{
+	QByteArray datagram;
+	QHostAddress sender;
+	while(_udpServer->hasPendingDatagrams())
+	{
+		datagram.resize(static_cast<int>(qMax(_udpServer->pendingDatagramSize(), qint64(0))));
+		if(_udpServer->readDatagram(datagram.data(), datagram.size(), &sender) < 0 || !FlatBufferDatagram::isValid(datagram))
+			continue;
+
+		// datagrams are accepted from registered clients only, access is checked on their TCP connection
+		FlatBufferClient* client = findClient(sender, FlatBufferDatagram::priority(datagram));
+		if(client == nullptr)
+			continue;
+
+		FlatBufferDatagram::Reassembler& reassembler = _reassemblers[client];
+		if(reassembler.add(datagram))
+		{
+			client->handleDatagram(reassembler.message());
+		}
+	}
+}
+
+FlatBufferClient* FlatBufferServer::findClient(const QHostAddress& address, int priority) const
+{
+	for(FlatBufferClient* client : _openConnections)
+	{
+		if(client->getPriority() == priority && isSameHost(client->getPeerAddress(), address))
+			return client;
+	}
+	return nullptr;
 }
 
 void FlatBufferServer::startServer()
@@ -106,6 +160,19 @@ void FlatBufferServer::startServer()
 		else
 		{
 			Info(_log,"Started on port %d", _port);
+
+			if(_udpEnabled)
+			{
+				if(!_udpServer->bind(QHostAddress::Any, _port))
+				{
+					Error(_log,"Failed to bind UDP port %d", _port);
+				}
+				else
+				{
+					_udpServer->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, UDP_RECEIVE_BUFFER_SIZE);
+					Info(_log,"Receiving images over UDP on port %d", _port);
+				}
+			}
 #ifdef ENABLE_AVAHI
 			if(_serviceRegister == nullptr)
 			{
@@ -133,6 +200,8 @@ void FlatBufferServer::stopServer()
 			client->forceClose();
 		}
 		_server->close();
+		_udpServer->close();
+		_reassemblers.clear();
 		Info(_log, "Stopped");
 	}
 }
@@ -0,0 +1,182 @@
+// project includes
+#include <forwarder/JsonForwardConnection.h>
+
+// qt includes
+#include <QJsonDocument>
+
+namespace {
+// delay of the first reconnect, doubled for each failed attempt
+const int RECONNECT_DELAY_MIN_MS = 500;
+const int RECONNECT_DELAY_MAX_MS = 30000;
+
+// abort connection attempts to hosts not answering at all
+const int CONNECT_TIMEOUT_MS = 3000;
+
+// messages are kept in the queue instead of the socket buffer, when the target does not read fast enough
+const qint64 MAX_BUFFERED_BYTES = 256 * 1024;
+const int MAX_QUEUED_MESSAGES = 64;
+
+// supersedes all queued messages
+const char SUPERSEDE_ALL[] = "*";
+}
+
+JsonForwardConnection::JsonForwardConnection(const QHostAddress& host, quint16 port, QObject* parent)
+	: QObject(parent)
+	, _log(Logger::getInstance("NETFORWARDER"))
+	, _host(host)
+	, _port(port)
+	, _socket(this)
+	, _connectTimer(this)
+	, _reconnectTimer(this)
+	, _reconnectDelay(RECONNECT_DELAY_MIN_MS)
+	, _superseded(0)
+	, _dropped(0)
+{
+	_connectTimer.setSingleShot(true);
+	_connectTimer.setInterval(CONNECT_TIMEOUT_MS);
+	_reconnectTimer.setSingleShot(true);
+
+	connect(&_connectTimer, &QTimer::timeout, this, &JsonForwardConnection::onConnectTimeout);
+	connect(&_reconnectTimer, &QTimer::timeout, this, &JsonForwardConnection::connectToHost);
+	connect(&_socket, &QTcpSocket::connected, this, &JsonForwardConnection::onConnected);
+	connect(&_socket, &QTcpSocket::stateChanged, this, &JsonForwardConnection::onStateChanged);
+	connect(&_socket, &QTcpSocket::readyRead, this, &JsonForwardConnection::readReply);
+	connect(&_socket, &QTcpSocket::bytesWritten, this, &JsonForwardConnection::writePending);
+
+	connectToHost();
+}
+
+JsonForwardConnection::~JsonForwardConnection()
+{
+	// closing is no reason to reconnect
+	disconnect(&_socket, nullptr, this, nullptr);
+	_socket.abort();
+}
+
+void JsonForwardConnection::sendMessage(const QJsonObject& message)
+{
+	// for hyperion classic compatibility
+	QJsonObject jsonMessage = message;
+	if (jsonMessage.contains("tan") && jsonMessage["tan"].isNull())
+	{
+		jsonMessage["tan"] = 100;
+	}
+
+	Message entry;
+	entry.key = supersedeKey(jsonMessage);
+	entry.data = QJsonDocument(jsonMessage).toJson(QJsonDocument::Compact) + "\n";
+
+	if (!entry.key.isEmpty())
+	{
+		// the target's end state is the same without the superseded messages
+		for (auto it = _queue.begin(); it != _queue.end();)
+		{
+			if (entry.key == SUPERSEDE_ALL || it->key == entry.key)
+			{
+				it = _queue.erase(it);
+				++_superseded;
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	if (_queue.size() >= MAX_QUEUED_MESSAGES)
+	{
+		if (_dropped == 0)
+		{
+			Warning(_log, "Queue of JSON-target host: %s port: %u is full, dropping messages", QSTRING_CSTR(_host.toString()), _port);
+		}
+		_queue.removeFirst();
+		++_dropped;
+	}
+	_queue.append(entry);
+
+	writePending();
+}
+
+void JsonForwardConnection::writePending()
+{
+	while (isConnected() && !_queue.isEmpty() && _socket.bytesToWrite() < MAX_BUFFERED_BYTES)
+	{
+		_socket.write(_queue.takeFirst().data);
+	}
+}
+
+void JsonForwardConnection::readReply()
+{
+	// replies are not evaluated
+	_socket.readAll();
+}
+
+void JsonForwardConnection::connectToHost()
+{
+	if (_socket.state() == QAbstractSocket::UnconnectedState)
+	{
+		_socket.connectToHost(_host, _port);
+		_connectTimer.start();
+	}
+}
+
+void JsonForwardConnection::onConnected()
+{
+	Info(_log, "Connected to JSON-target host: %s port: %u", QSTRING_CSTR(_host.toString()), _port);
+	_connectTimer.stop();
+	_reconnectDelay = RECONNECT_DELAY_MIN_MS;
+	writePending();
+}
+
+void JsonForwardConnection::onConnectTimeout()
+{
+	// results in the unconnected state and a reconnect
+	_socket.abort();
+}
+
+void JsonForwardConnection::onStateChanged(QAbstractSocket::SocketState state)
+{
+	if (state == QAbstractSocket::UnconnectedState)
+	{
+		_connectTimer.stop();
+		scheduleReconnect();
+	}
+}
+
+void JsonForwardConnection::scheduleReconnect()
+{
+	if (_reconnectTimer.isActive())
+	{
+		return;
+	}
+
+	if (_reconnectDelay == RECONNECT_DELAY_MIN_MS)
+	{
+		Warning(_log, "JSON-target host: %s port: %u is not reachable, retrying in the background", QSTRING_CSTR(_host.toString()), _port);
+	}
+	else
+	{
+		Debug(_log, "Reconnecting to JSON-target host: %s port: %u in %d ms", QSTRING_CSTR(_host.toString()), _port, _reconnectDelay);
+	}
+
+	_reconnectTimer.start(_reconnectDelay);
+	_reconnectDelay = qMin(_reconnectDelay * 2, RECONNECT_DELAY_MAX_MS);
+}
+
+QString JsonForwardConnection::supersedeKey(const QJsonObject& message)
+{
+	const QString command = message["command"].toString();
+	const int priority = message["priority"].toInt(-1);
+
+	if (command == "clearall" || (command == "clear" && priority < 0))
+	{
+		return SUPERSEDE_ALL;
+	}
+
+	// the latest of these messages defines what the priority shows
+	if (command == "color" || command == "image" || command == "effect" || command == "clear")
+	{
+		return QString("priority:%1").arg(priority);
+	}
+	return QString();
+}
@@ -3,6 +3,7 @@
 
 // project includes
 #include <forwarder/MessageForwarder.h>
+#include <forwarder/JsonForwardConnection.h>
 
 // hyperion includes
 #include <hyperion/Hyperion.h>
@@ -12,8 +13,6 @@
 #include <utils/NetUtils.h>
 
 // qt includes
-#include <QTcpServer>
-#include <QTcpSocket>
 #include <QHostInfo>
 #include <QNetworkInterface>
 
@@ -44,6 +43,7 @@ MessageForwarder::MessageForwarder(Hyperion* hyperion)
 
 MessageForwarder::~MessageForwarder()
 {
+	qDeleteAll(_jsonClients);
 	while (!_forwardClients.isEmpty())
 	{
 		delete _forwardClients.takeFirst();
@@ -56,6 +56,8 @@ void MessageForwarder::handleSettingsUpdate(settings::type type, const QJsonDocu
 	{
 		// clear the current targets
 		_jsonTargets.clear();
+		qDeleteAll(_jsonClients);
+		_jsonClients.clear();
 		_flatbufferTargets.clear();
 		while (!_forwardClients.isEmpty())
 		{
@@ -199,6 +201,7 @@ void MessageForwarder::addJsonTarget(const QJsonObject& targetConfig)
 					{
 						Info(_log, "JSON-Forwarder settings: Adding target host: %s port: %u", QSTRING_CSTR(targetHost.host.toString()), targetHost.port);
 						_jsonTargets << targetHost;
+						_jsonClients << new JsonForwardConnection(targetHost.host, targetHost.port);
 					}
 					else
 					{
@@ -255,73 +258,22 @@ void MessageForwarder::forwardJsonMessage(const QJsonObject& message)
 {
 	if (_forwarder_enabled)
 	{
-		QTcpSocket client;
-		for (const auto& targetHost : qAsConst(_jsonTargets))
+		for (JsonForwardConnection* client : qAsConst(_jsonClients))
 		{
-			client.connectToHost(targetHost.host, targetHost.port);
-			if (client.waitForConnected(500))
-			{
-				sendJsonMessage(message, &client);
-				client.close();
-			}
+			client->sendMessage(message);
 		}
 	}
 }
 
 void MessageForwarder::forwardFlatbufferMessage(const QString& /*name*/, const Image<ColorRgb>& image)
 {
-	if (_forwarder_enabled)
+	if (_forwarder_enabled && !_forwardClients.isEmpty())
 	{
-		for (int i = 0; i < _forwardClients.size(); i++)
+		// serialize once, all targets share the message
+		const QByteArray message = FlatBufferConnection::encodeImage(image);
+		for (FlatBufferConnection* client : qAsConst(_forwardClients))
 		{
-			_forwardClients.at(i)->setImage(image);
+			client->sendImage(message);
 		}
 	}
 }
-
-void MessageForwarder::sendJsonMessage(const QJsonObject& message, QTcpSocket* socket)
-{
-	// for hyperion classic compatibility
-	QJsonObject jsonMessage = message;
-	if (jsonMessage.contains("tan") && jsonMessage["tan"].isNull())
-	{
-		jsonMessage["tan"] = 100;
-	}
-
-	// serialize message
-	QJsonDocument writer(jsonMessage);
-	QByteArray serializedMessage = writer.toJson(QJsonDocument::Compact) + "\n";
-
-	// write message
-	socket->write(serializedMessage);
-	if (!socket->waitForBytesWritten())
-	{
-		Debug(_log, "Error while writing data to host");
-		return;
-	}
-
-	// read reply data
-	QByteArray serializedReply;
-	while (!serializedReply.contains('\n'))
-	{
-		// receive reply
-		if (!socket->waitForReadyRead())
-		{
-			Debug(_log, "Error while writing data from host");
-			return;
-		}
-
-		serializedReply += socket->readAll();
-	}
-
-	// parse reply data
-	QJsonParseError error;
-	QJsonDocument::fromJson(serializedReply, &error);
-
-	if (error.error != QJsonParseError::NoError)
-	{
-		Error(_log, "Error while parsing reply: invalid json");
-		return;
-	}
-}
-
@@ -34,6 +34,8 @@ FramebufferFrameGrabber::FramebufferFrameGrabber(const QString & device)
 	: Grabber("FRAMEBUFFERGRABBER")
 	  , _fbDevice(device)
 	  , _fbfd (-1)
+	  , _fbp(nullptr)
+	  , _fbpSize(0)
 {
 	_useImageResampler = true;
 }
@@ -74,37 +76,59 @@ int FramebufferFrameGrabber::grabFrame(Image<ColorRgb> & image)
 
 	if (_isEnabled && !_isDeviceInError)
 	{
-		if ( getScreenInfo() )
+		if ( checkScreenMode() )
 		{
-			/* map the device to memory */
-			uint8_t * fbp = static_cast<uint8_t*>(mmap(nullptr, _fixInfo.smem_len, PROT_READ, MAP_PRIVATE | MAP_NORESERVE, _fbfd, 0));
-			if (fbp == MAP_FAILED) {
-
-				QString errorReason = QString ("Error mapping %1, [%2] %3").arg(_fbDevice).arg(errno).arg(std::strerror(errno));
-				this->setInError ( errorReason );
-				closeDevice();
-				rc = -1;
-			}
-			else
-			{
-				_imageResampler.processImage(fbp,
-											  static_cast<int>(_varInfo.xres),
-											  static_cast<int>(_varInfo.yres),
-											  static_cast<int>(_fixInfo.line_length),
-											  _pixelFormat,
-											  image);
-				munmap(fbp, _fixInfo.smem_len);
-			}
+			_imageResampler.processImage(_fbp,
+										  static_cast<int>(_varInfo.xres),
+										  static_cast<int>(_varInfo.yres),
+										  static_cast<int>(_fixInfo.line_length),
+										  _pixelFormat,
+										  image);
+		}
+		else
+		{
+			rc = -1;
 		}
-		closeDevice();
 	}
 	return rc;
 }
 
+bool FramebufferFrameGrabber::checkScreenMode()
+{
+	if (_fbfd < 0 || _fbp == nullptr)
+	{
+		return getScreenInfo();
+	}
+
+	// a single ioctl per frame, the device is only set up again on a mode change
+	struct fb_var_screeninfo varInfo;
+	if (!queryVarInfo(_fbfd, varInfo))
+	{
+		QString errorReason = QString ("Error getting screen information for %1, [%2] %3").arg(_fbDevice).arg(errno).arg(std::strerror(errno));
+		this->setInError ( errorReason );
+		closeDevice();
+		return false;
+	}
+
+	if (varInfo.xres != _varInfo.xres || varInfo.yres != _varInfo.yres
+		|| varInfo.bits_per_pixel != _varInfo.bits_per_pixel || varInfo.red.offset != _varInfo.red.offset)
+	{
+		Debug(_log, "Screen mode of %s changed to %dx%d, %d bits per pixel", QSTRING_CSTR(_fbDevice), varInfo.xres, varInfo.yres, varInfo.bits_per_pixel);
+		closeDevice();
+		return getScreenInfo();
+	}
+	return true;
+}
+
 bool FramebufferFrameGrabber::openDevice()
 {
 	bool rc = true;
 
+	if (_fbfd >= 0)
+	{
+		return rc;
+	}
+
 	/* Open the framebuffer device */
 	_fbfd = ::open(QSTRING_CSTR(_fbDevice), O_RDONLY);
 	if (_fbfd < 0)
@@ -119,6 +143,8 @@ bool FramebufferFrameGrabber::openDevice()
 bool FramebufferFrameGrabber::closeDevice()
 {
 	bool rc = false;
+
+	unmapDevice();
 	if (_fbfd >= 0)
 	{
 		if( ::close(_fbfd) == 0) {
@@ -129,6 +155,44 @@ bool FramebufferFrameGrabber::closeDevice()
 	return rc;
 }
 
+bool FramebufferFrameGrabber::mapDevice()
+{
+	unmapDevice();
+
+	/* map the device to memory, a shared read-only mapping follows the screen content */
+	void * fbp = mmap(nullptr, _fixInfo.smem_len, PROT_READ, MAP_SHARED | MAP_NORESERVE, _fbfd, 0);
+	if (fbp == MAP_FAILED)
+	{
+		QString errorReason = QString ("Error mapping %1, [%2] %3").arg(_fbDevice).arg(errno).arg(std::strerror(errno));
+		this->setInError ( errorReason );
+		return false;
+	}
+
+	_fbp = static_cast<uint8_t*>(fbp);
+	_fbpSize = _fixInfo.smem_len;
+	return true;
+}
+
+void FramebufferFrameGrabber::unmapDevice()
+{
+	if (_fbp != nullptr)
+	{
+		munmap(_fbp, _fbpSize);
+		_fbp = nullptr;
+		_fbpSize = 0;
+	}
+}
+
+bool FramebufferFrameGrabber::queryFixInfo(int fd, struct fb_fix_screeninfo & fixInfo) const
+{
+	return ioctl(fd, FBIOGET_FSCREENINFO, &fixInfo) == 0;
+}
+
+bool FramebufferFrameGrabber::queryVarInfo(int fd, struct fb_var_screeninfo & varInfo) const
+{
+	return ioctl(fd, FBIOGET_VSCREENINFO, &varInfo) == 0;
+}
+
 QSize FramebufferFrameGrabber::getScreenSize() const
 {
 	return getScreenSize(_fbDevice);
@@ -161,7 +225,7 @@ bool FramebufferFrameGrabber::getScreenInfo()
 
 	if ( openDevice() )
 	{
-		if (ioctl(_fbfd, FBIOGET_FSCREENINFO, &_fixInfo) < 0 || ioctl (_fbfd, FBIOGET_VSCREENINFO, &_varInfo) < 0)
+		if (!queryFixInfo(_fbfd, _fixInfo) || !queryVarInfo(_fbfd, _varInfo))
 		{
 			QString errorReason = QString ("Error getting screen information for %1, [%2] %3").arg(_fbDevice).arg(errno).arg(std::strerror(errno));
 			this->setInError ( errorReason );
@@ -176,7 +240,7 @@ bool FramebufferFrameGrabber::getScreenInfo()
 				break;
 			case 24: _pixelFormat = PixelFormat::BGR24;
 				break;
-			case 32: _pixelFormat = PixelFormat::BGR32;
+			case 32: _pixelFormat = (_varInfo.red.offset == 0) ? PixelFormat::RGB32 : PixelFormat::BGR32;
 				break;
 			default:
 				rc= false;
@@ -184,6 +248,20 @@ bool FramebufferFrameGrabber::getScreenInfo()
 				this->setInError ( errorReason );
 				closeDevice();
 			}
+
+			if (rc && static_cast<quint64>(_fixInfo.line_length) * _varInfo.yres > _fixInfo.smem_len)
+			{
+				rc = false;
+				QString errorReason = QString ("Screen of %1 exceeds the framebuffer memory").arg(_fbDevice);
+				this->setInError ( errorReason );
+				closeDevice();
+			}
+
+			if (rc && !mapDevice())
+			{
+				rc = false;
+				closeDevice();
+			}
 		}
 	}
 	return rc;
@@ -1,5 +1,7 @@
 #include "grabber/EncoderThread.h"
 
+#include <utils/Metrics.h>
+
 EncoderThread::EncoderThread()
 	: _localData(nullptr)
 	, _scalingFactorsCount(0)
@@ -80,6 +82,7 @@ void EncoderThread::process()
 	_busy = true;
 	if (_width > 0 && _height > 0)
 	{
+		Metrics::ScopedTimer timer(Metrics::DECODE);
 #ifdef HAVE_TURBO_JPEG
 		if (_pixelFormat == PixelFormat::MJPEG)
 		{
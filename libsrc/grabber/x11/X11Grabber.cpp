@@ -18,6 +18,8 @@ X11Grabber::X11Grabber(int cropLeft, int cropRight, int cropTop, int cropBottom)
 	, _dstFormat(nullptr)
 	, _srcPicture(None)
 	, _dstPicture(None)
+	, _damage(None)
+	, _XDamageEventBase(0)
 	, _calculatedWidth(0)
 	, _calculatedHeight(0)
 	, _src_x(cropLeft)
@@ -25,7 +27,10 @@ X11Grabber::X11Grabber(int cropLeft, int cropRight, int cropTop, int cropBottom)
 	, _XShmAvailable(false)
 	, _XRenderAvailable(false)
 	, _XRandRAvailable(false)
+	, _XDamageAvailable(false)
 	, _isWayland (false)
+	, _damageTracking(false)
+	, _isDamaged(false)
 	, _logger{}
 	, _image(0,0)
 {
@@ -69,6 +74,11 @@ void X11Grabber::freeResources()
 		XRenderFreePicture(_x11Display, _dstPicture);
 		XFreePixmap(_x11Display, _pixmap);
 	}
+	if (_damage != None)
+	{
+		XDamageDestroy(_x11Display, _damage);
+		_damage = None;
+	}
 }
 
 void X11Grabber::setupResources()
@@ -115,6 +125,13 @@ void X11Grabber::setupResources()
 		_imageResampler.setHorizontalPixelDecimation(_pixelDecimation);
 		_imageResampler.setVerticalPixelDecimation(_pixelDecimation);
 	}
+
+	if (_damageTracking && _XDamageAvailable)
+	{
+		_damage = XDamageCreate(_x11Display, _window, XDamageReportNonEmpty);
+		// always grab the first frame
+		_isDamaged = true;
+	}
 }
 
 bool X11Grabber::open()
@@ -169,12 +186,14 @@ bool X11Grabber::setupDisplay()
 		_XShmAvailable = XShmQueryExtension(_x11Display);
 		XShmQueryVersion(_x11Display, &dummy, &dummy, &pixmaps_supported);
 		_XShmPixmapAvailable = pixmaps_supported && XShmPixmapFormat(_x11Display) == ZPixmap;
+		_XDamageAvailable = XDamageQueryExtension(_x11Display, &_XDamageEventBase, &dummy);
 
-		Info(_log, QString("XRandR=[%1] XRender=[%2] XShm=[%3] XPixmap=[%4]")
+		Info(_log, QString("XRandR=[%1] XRender=[%2] XShm=[%3] XPixmap=[%4] XDamage=[%5]")
 			 .arg(_XRandRAvailable     ? "available" : "unavailable")
 			 .arg(_XRenderAvailable    ? "available" : "unavailable")
 			 .arg(_XShmAvailable       ? "available" : "unavailable")
 			 .arg(_XShmPixmapAvailable ? "available" : "unavailable")
+			 .arg(_XDamageAvailable    ? "available" : "unavailable")
 			 .toStdString().c_str());
 
 		result = (updateScreenDimensions(true) >=0);
@@ -191,6 +210,12 @@ int X11Grabber::grabFrame(Image<ColorRgb> & image, bool forceUpdate)
 	if (forceUpdate)
 		updateScreenDimensions(forceUpdate);
 
+	if (_damage != None && !forceUpdate && !isScreenDamaged())
+	{
+		// screen content unchanged since the last grab
+		return 1;
+	}
+
 	if (_XRenderAvailable)
 	{
 		double scale_x = static_cast<double>(_windowAttr.width / _pixelDecimation) / static_cast<double>(_windowAttr.width);
@@ -226,8 +251,7 @@ int X11Grabber::grabFrame(Image<ColorRgb> & image, bool forceUpdate)
 			_x11Display, PictOpSrc, _srcPicture, None, _dstPicture, ( _src_x/_pixelDecimation),
 			(_src_y/_pixelDecimation), 0, 0, 0, 0, _calculatedWidth, _calculatedHeight);
 
-		XSync(_x11Display, False);
-
+		// no XSync required, requests are processed in order and the image request waits for its reply
 		if (_XShmAvailable)
 		{
 			XShmGetImage(_x11Display, _pixmap, _xImage, 0, 0, AllPlanes);
@@ -259,6 +283,29 @@ int X11Grabber::grabFrame(Image<ColorRgb> & image, bool forceUpdate)
 	return 0;
 }
 
+bool X11Grabber::isScreenDamaged()
+{
+	XEvent event;
+	while (XPending(_x11Display) > 0)
+	{
+		XNextEvent(_x11Display, &event);
+		if (event.type == _XDamageEventBase + XDamageNotify)
+		{
+			_isDamaged = true;
+		}
+	}
+
+	if (!_isDamaged)
+	{
+		return false;
+	}
+
+	// acknowledge before grabbing, so changes during the grab raise a new notify event
+	XDamageSubtract(_x11Display, _damage, None, None);
+	_isDamaged = false;
+	return true;
+}
+
 int X11Grabber::updateScreenDimensions(bool force)
 {
 	const Status status = XGetWindowAttributes(_x11Display, _window, &_windowAttr);
@@ -378,6 +425,20 @@ void X11Grabber::setCropping(int cropLeft, int cropRight, int cropTop, int cropB
 	}
 }
 
+void X11Grabber::setDamageTracking(bool enable)
+{
+	if (_damageTracking != enable)
+	{
+		_damageTracking = enable;
+		Info(_log, "Capture on screen changes only: %s", enable ? "enabled" : "disabled");
+		WarningIf(enable && _x11Display != nullptr && !_XDamageAvailable, _log, "XDamage is not available, capturing every frame");
+		if(_x11Display != nullptr)
+		{
+			updateScreenDimensions(true);
+		}
+	}
+}
+
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
 bool X11Grabber::nativeEventFilter(const QByteArray & eventType, void * message, qintptr * /*result*/)
 #else
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <xcb/damage.h>
 #include <xcb/randr.h>
 #include <xcb/shm.h>
 #include <xcb/xcb.h>
@@ -141,3 +142,34 @@ struct FreePixmap
 	static constexpr auto ReplyFunction = xcb_request_check;
 };
 
+struct DamageQueryVersion
+{
+	typedef xcb_damage_query_version_reply_t ResponseType;
+
+	static constexpr auto RequestFunction = xcb_damage_query_version;
+	static constexpr auto ReplyFunction = xcb_damage_query_version_reply;
+};
+
+struct DamageCreate
+{
+	typedef xcb_void_cookie_t ResponseType;
+
+	static constexpr auto RequestFunction = xcb_damage_create_checked;
+	static constexpr auto ReplyFunction = xcb_request_check;
+};
+
+struct DamageSubtract
+{
+	typedef xcb_void_cookie_t ResponseType;
+
+	static constexpr auto RequestFunction = xcb_damage_subtract_checked;
+	static constexpr auto ReplyFunction = xcb_request_check;
+};
+
+struct DamageDestroy
+{
+	typedef xcb_void_cookie_t ResponseType;
+
+	static constexpr auto RequestFunction = xcb_damage_destroy_checked;
+	static constexpr auto ReplyFunction = xcb_request_check;
+};
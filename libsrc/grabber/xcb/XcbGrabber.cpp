@@ -28,6 +28,7 @@ XcbGrabber::XcbGrabber(int cropLeft, int cropRight, int cropTop, int cropBottom)
 	, _dstPicture{}
 	, _transform{}
 	, _shminfo{}
+	, _damage{}
 	, _screenWidth{}
 	, _screenHeight{}
 	, _src_x(cropLeft)
@@ -36,10 +37,19 @@ XcbGrabber::XcbGrabber(int cropLeft, int cropRight, int cropTop, int cropBottom)
 	, _XcbRandRAvailable{}
 	, _XcbShmAvailable{}
 	, _XcbShmPixmapAvailable{}
+	, _XcbDamageAvailable{}
 	, _isWayland (false)
+	, _damageTracking{}
+	, _isDamaged{}
 	, _logger{}
+	, _shmId{}
 	, _shmData{}
+	, _bufferCount(1)
+	, _asyncCapture{}
+	, _pendingBuffer(-1)
+	, _pendingCookie{}
 	, _XcbRandREventBase{-1}
+	, _XcbDamageEventBase{-1}
 {
 	_logger = Logger::getInstance("XCB");
 
@@ -64,19 +74,38 @@ void XcbGrabber::freeResources()
 		qApp->removeNativeEventFilter(this);
 	}
 
-	if(_XcbShmAvailable)
+	if (_pendingBuffer >= 0)
 	{
-		query<ShmDetach>(_connection, _shminfo);
-		shmdt(_shmData);
-		shmctl(_shminfo, IPC_RMID, 0);
+		// drop the reply of a frame still in flight
+		xcb_discard_reply(_connection, _pendingCookie.sequence);
+		_pendingBuffer = -1;
+	}
 
+	for (int i = 0; i < _bufferCount; ++i)
+	{
+		if(_XcbShmAvailable)
+		{
+			query<ShmDetach>(_connection, _shminfo[i]);
+			shmdt(_shmData[i]);
+			shmctl(_shmId[i], IPC_RMID, 0);
+		}
+
+		if (_XcbRenderAvailable)
+		{
+			query<FreePixmap>(_connection, _pixmap[i]);
+			query<RenderFreePicture>(_connection, _dstPicture[i]);
+		}
 	}
 
 	if (_XcbRenderAvailable)
 	{
-		query<FreePixmap>(_connection, _pixmap);
 		query<RenderFreePicture>(_connection, _srcPicture);
-		query<RenderFreePicture>(_connection, _dstPicture);
+	}
+
+	if (_damage != XCB_NONE)
+	{
+		query<DamageDestroy>(_connection, _damage);
+		_damage = XCB_NONE;
 	}
 }
 
@@ -87,12 +116,19 @@ void XcbGrabber::setupResources()
 		qApp->installNativeEventFilter(this);
 	}
 
+	// asynchronous capture pipelines the XRender composite of the next frame into a second buffer
+	_bufferCount = (_asyncCapture && _XcbRenderAvailable && _XcbShmAvailable) ? CAPTURE_BUFFERS : 1;
+	_pendingBuffer = -1;
+
 	if(_XcbShmAvailable)
 	{
-		_shminfo = xcb_generate_id(_connection);
-		int id = shmget(IPC_PRIVATE, size_t(_width) * size_t(_height) * 4, IPC_CREAT | 0777);
-		_shmData = static_cast<uint8_t*>(shmat(id, nullptr, 0));
-		query<ShmAttach>(_connection, _shminfo, id, 0);
+		for (int i = 0; i < _bufferCount; ++i)
+		{
+			_shminfo[i] = xcb_generate_id(_connection);
+			_shmId[i] = shmget(IPC_PRIVATE, size_t(_width) * size_t(_height) * 4, IPC_CREAT | 0777);
+			_shmData[i] = static_cast<uint8_t*>(shmat(_shmId[i], nullptr, 0));
+			query<ShmAttach>(_connection, _shminfo[i], _shmId[i], 0);
+		}
 	}
 
 	if (_XcbRenderAvailable)
@@ -101,33 +137,48 @@ void XcbGrabber::setupResources()
 		_imageResampler.setHorizontalPixelDecimation(1);
 		_imageResampler.setVerticalPixelDecimation(1);
 
-		if(_XcbShmPixmapAvailable)
-		{
-			_pixmap = xcb_generate_id(_connection);
-			query<ShmCreatePixmap>(
-				_connection, _pixmap, _screen->root, _width,
-				_height, _screen->root_depth, _shminfo, 0);
-		}
-		else
-		{
-			_pixmap = xcb_generate_id(_connection);
-			query<CreatePixmap>(_connection, _screen->root_depth, _pixmap, _screen->root, _width, _height);
-		}
-
 		_srcFormat = findFormatForVisual(_screen->root_visual);
 		_dstFormat = findFormatForVisual(_screen->root_visual);
 
-		_srcPicture = xcb_generate_id(_connection);
-		_dstPicture = xcb_generate_id(_connection);
-
 		const uint32_t value_mask = XCB_RENDER_CP_REPEAT;
 		const uint32_t values[] = { XCB_RENDER_REPEAT_NONE };
 
+		for (int i = 0; i < _bufferCount; ++i)
+		{
+			_pixmap[i] = xcb_generate_id(_connection);
+			if(_XcbShmPixmapAvailable)
+			{
+				query<ShmCreatePixmap>(
+					_connection, _pixmap[i], _screen->root, _width,
+					_height, _screen->root_depth, _shminfo[i], 0);
+			}
+			else
+			{
+				query<CreatePixmap>(_connection, _screen->root_depth, _pixmap[i], _screen->root, _width, _height);
+			}
+
+			_dstPicture[i] = xcb_generate_id(_connection);
+			query<RenderCreatePicture>(_connection, _dstPicture[i], _pixmap[i], _dstFormat, value_mask, values);
+		}
+
+		_srcPicture = xcb_generate_id(_connection);
 		query<RenderCreatePicture>(_connection, _srcPicture, _screen->root, _srcFormat, value_mask, values);
-		query<RenderCreatePicture>(_connection, _dstPicture, _pixmap, _dstFormat, value_mask, values);
 
 		const std::string filter = "fast";
 		query<RenderSetPictureFilter>(_connection, _srcPicture, filter.size(), filter.c_str(), 0, nullptr);
+
+		// the scaling transform only depends on the screen dimensions, set it once per setup
+		double scale_x = static_cast<double>(_screenWidth / _pixelDecimation) / static_cast<double>(_screenWidth);
+		double scale_y = static_cast<double>(_screenHeight / _pixelDecimation) / static_cast<double>(_screenHeight);
+		double scale = qMin(scale_y, scale_x);
+
+		_transform = {
+			DOUBLE_TO_FIXED(1), DOUBLE_TO_FIXED(0), DOUBLE_TO_FIXED(0),
+			DOUBLE_TO_FIXED(0), DOUBLE_TO_FIXED(1), DOUBLE_TO_FIXED(0),
+			DOUBLE_TO_FIXED(0), DOUBLE_TO_FIXED(0), DOUBLE_TO_FIXED(scale)
+		};
+
+		query<RenderSetPictureTransform>(_connection, _srcPicture, _transform);
 	}
 	else
 	{
@@ -135,6 +186,14 @@ void XcbGrabber::setupResources()
 		_imageResampler.setHorizontalPixelDecimation(_pixelDecimation);
 		_imageResampler.setVerticalPixelDecimation(_pixelDecimation);
 	}
+
+	if (_damageTracking && _XcbDamageAvailable)
+	{
+		_damage = xcb_generate_id(_connection);
+		query<DamageCreate>(_connection, _damage, _screen->root, XCB_DAMAGE_REPORT_LEVEL_NON_EMPTY);
+		// always grab the first frame
+		_isDamaged = true;
+	}
 }
 
 xcb_screen_t * XcbGrabber::getScreen(const xcb_setup_t *setup, int screen_num) const
@@ -182,6 +241,22 @@ void XcbGrabber::setupShm()
 	}
 }
 
+void XcbGrabber::setupDamage()
+{
+	auto damageQueryExtensionReply = xcb_get_extension_data(_connection, &xcb_damage_id);
+	_XcbDamageAvailable = false;
+	_XcbDamageEventBase = -1;
+
+	if (damageQueryExtensionReply != nullptr && damageQueryExtensionReply->present)
+	{
+		// the damage extension must be version negotiated before use
+		auto damageQueryVersionReply = query<DamageQueryVersion>(_connection, XCB_DAMAGE_MAJOR_VERSION, XCB_DAMAGE_MINOR_VERSION);
+
+		_XcbDamageAvailable = damageQueryVersionReply != nullptr;
+		_XcbDamageEventBase = damageQueryExtensionReply->first_event;
+	}
+}
+
 bool XcbGrabber::open()
 {
 	bool rc = false;
@@ -241,12 +316,14 @@ bool XcbGrabber::setupDisplay()
 		setupRandr();
 		setupRender();
 		setupShm();
+		setupDamage();
 
-		Info(_log, QString("XcbRandR=[%1] XcbRender=[%2] XcbShm=[%3] XcbPixmap=[%4]")
+		Info(_log, QString("XcbRandR=[%1] XcbRender=[%2] XcbShm=[%3] XcbPixmap=[%4] XcbDamage=[%5]")
 			 .arg(_XcbRandRAvailable     ? "available" : "unavailable")
 			 .arg(_XcbRenderAvailable    ? "available" : "unavailable")
 			 .arg(_XcbShmAvailable       ? "available" : "unavailable")
 			 .arg(_XcbShmPixmapAvailable ? "available" : "unavailable")
+			 .arg(_XcbDamageAvailable    ? "available" : "unavailable")
 			 .toStdString().c_str());
 
 		result = (updateScreenDimensions(true) >= 0);
@@ -264,22 +341,18 @@ int XcbGrabber::grabFrame(Image<ColorRgb> & image, bool forceUpdate)
 	if (forceUpdate)
 		updateScreenDimensions(forceUpdate);
 
+	// screen content unchanged since the last grab, just deliver a frame still in flight
+	if (_damage != XCB_NONE && !forceUpdate && !isScreenDamaged())
+		return (_pendingBuffer >= 0) ? grabFramePipelined(image, false) : 1;
+
 	if (_XcbRenderAvailable)
 	{
-		double scale_x = static_cast<double>(_screenWidth / _pixelDecimation) / static_cast<double>(_screenWidth);
-		double scale_y = static_cast<double>(_screenHeight / _pixelDecimation) / static_cast<double>(_screenHeight);
-		double scale = qMin(scale_y, scale_x);
-
-		_transform = {
-			DOUBLE_TO_FIXED(1), DOUBLE_TO_FIXED(0), DOUBLE_TO_FIXED(0),
-			DOUBLE_TO_FIXED(0), DOUBLE_TO_FIXED(1), DOUBLE_TO_FIXED(0),
-			DOUBLE_TO_FIXED(0), DOUBLE_TO_FIXED(0), DOUBLE_TO_FIXED(scale)
-		};
+		if (_bufferCount > 1)
+			return grabFramePipelined(image, true);
 
-		query<RenderSetPictureTransform>(_connection, _srcPicture, _transform);
 		query<RenderComposite>(_connection,
 			XCB_RENDER_PICT_OP_SRC, _srcPicture,
-			XCB_RENDER_PICTURE_NONE, _dstPicture,
+			XCB_RENDER_PICTURE_NONE, _dstPicture[0],
 			(_src_x/_pixelDecimation),
 			(_src_y/_pixelDecimation),
 			0, 0, 0, 0, _width, _height);
@@ -289,17 +362,17 @@ int XcbGrabber::grabFrame(Image<ColorRgb> & image, bool forceUpdate)
 		if (_XcbShmAvailable)
 		{
 			query<ShmGetImage>(_connection,
-				_pixmap, 0, 0, _width, _height,
-				~0, XCB_IMAGE_FORMAT_Z_PIXMAP, _shminfo, 0);
+				_pixmap[0], 0, 0, _width, _height,
+				~0, XCB_IMAGE_FORMAT_Z_PIXMAP, _shminfo[0], 0);
 
 			_imageResampler.processImage(
-				reinterpret_cast<const uint8_t *>(_shmData),
+				reinterpret_cast<const uint8_t *>(_shmData[0]),
 				_width, _height, _width * 4, PixelFormat::BGR32, image);
 		}
 		else
 		{
 			auto result = query<GetImage>(_connection,
-				XCB_IMAGE_FORMAT_Z_PIXMAP, _pixmap,
+				XCB_IMAGE_FORMAT_Z_PIXMAP, _pixmap[0],
 				0, 0, _width, _height, ~0);
 
 			auto buffer = xcb_get_image_data(result.get());
@@ -314,10 +387,10 @@ int XcbGrabber::grabFrame(Image<ColorRgb> & image, bool forceUpdate)
 	{
 		query<ShmGetImage>(_connection,
 			_screen->root, _src_x, _src_y, _width, _height,
-			~0, XCB_IMAGE_FORMAT_Z_PIXMAP, _shminfo, 0);
+			~0, XCB_IMAGE_FORMAT_Z_PIXMAP, _shminfo[0], 0);
 
 		_imageResampler.processImage(
-			reinterpret_cast<const uint8_t *>(_shmData),
+			reinterpret_cast<const uint8_t *>(_shmData[0]),
 			_width, _height, _width * 4, PixelFormat::BGR32, image);
 	}
 	else
@@ -336,6 +409,83 @@ int XcbGrabber::grabFrame(Image<ColorRgb> & image, bool forceUpdate)
 	return 0;
 }
 
+xcb_shm_get_image_cookie_t XcbGrabber::requestFrame(int buffer)
+{
+	// unchecked requests, errors are reported via the event queue
+	xcb_render_composite(_connection,
+		XCB_RENDER_PICT_OP_SRC, _srcPicture,
+		XCB_RENDER_PICTURE_NONE, _dstPicture[buffer],
+		(_src_x/_pixelDecimation),
+		(_src_y/_pixelDecimation),
+		0, 0, 0, 0, _width, _height);
+
+	xcb_shm_get_image_cookie_t cookie = xcb_shm_get_image(_connection,
+		_pixmap[buffer], 0, 0, _width, _height,
+		~0, XCB_IMAGE_FORMAT_Z_PIXMAP, _shminfo[buffer], 0);
+
+	xcb_flush(_connection);
+
+	return cookie;
+}
+
+int XcbGrabber::grabFramePipelined(Image<ColorRgb> & image, bool requestNext)
+{
+	// prime the pipeline on the first grab
+	if (_pendingBuffer < 0)
+	{
+		_pendingBuffer = 0;
+		_pendingCookie = requestFrame(_pendingBuffer);
+	}
+
+	const int current = _pendingBuffer;
+	const xcb_shm_get_image_cookie_t cookie = _pendingCookie;
+	_pendingBuffer = -1;
+
+	// the X server composites the next frame while the current one is resampled
+	if (requestNext)
+	{
+		_pendingBuffer = (current + 1) % CAPTURE_BUFFERS;
+		_pendingCookie = requestFrame(_pendingBuffer);
+	}
+
+	xcb_generic_error_t * error = nullptr;
+	std::unique_ptr<xcb_shm_get_image_reply_t, decltype(&free)> reply(
+		xcb_shm_get_image_reply(_connection, cookie, &error), free);
+
+	if (error != nullptr || reply == nullptr)
+	{
+		check_error(error);
+		return -1;
+	}
+
+	_imageResampler.processImage(
+		reinterpret_cast<const uint8_t *>(_shmData[current]),
+		_width, _height, _width * 4, PixelFormat::BGR32, image);
+
+	return 0;
+}
+
+bool XcbGrabber::isScreenDamaged()
+{
+	xcb_generic_event_t * event;
+	while ((event = xcb_poll_for_event(_connection)) != nullptr)
+	{
+		if (XCB_EVENT_RESPONSE_TYPE(event) == _XcbDamageEventBase + XCB_DAMAGE_NOTIFY)
+			_isDamaged = true;
+
+		free(event);
+	}
+
+	if (!_isDamaged)
+		return false;
+
+	// acknowledge before grabbing, so changes during the grab raise a new notify event
+	query<DamageSubtract>(_connection, _damage, XCB_NONE, XCB_NONE);
+	_isDamaged = false;
+
+	return true;
+}
+
 int XcbGrabber::updateScreenDimensions(bool force)
 {
 	auto geometry = query<GetGeometry>(_connection, _screen->root);
@@ -450,6 +600,31 @@ void XcbGrabber::setCropping(int cropLeft, int cropRight, int cropTop, int cropB
 		updateScreenDimensions(true);
 }
 
+void XcbGrabber::setDamageTracking(bool enable)
+{
+	if (_damageTracking == enable)
+		return;
+
+	_damageTracking = enable;
+	Info(_log, "Capture on screen changes only: %s", enable ? "enabled" : "disabled");
+	WarningIf(enable && _connection != nullptr && !_XcbDamageAvailable, _log, "XcbDamage is not available, capturing every frame");
+
+	if(_connection != nullptr)
+		updateScreenDimensions(true);
+}
+
+void XcbGrabber::setAsyncCapture(bool enable)
+{
+	if (_asyncCapture == enable)
+		return;
+
+	_asyncCapture = enable;
+	Info(_log, "Asynchronous (double buffered) capture: %s", enable ? "enabled" : "disabled");
+
+	if(_connection != nullptr)
+		updateScreenDimensions(true);
+}
+
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
 bool XcbGrabber::nativeEventFilter(const QByteArray & eventType, void * message, qintptr * /*result*/)
 #else
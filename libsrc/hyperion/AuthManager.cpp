@@ -10,6 +10,11 @@
 
 AuthManager *AuthManager::manager = nullptr;
 
+namespace {
+// interval in which the last use of tokens is written to the database
+const int LAST_USE_WRITE_INTERVAL_MS = 60000;
+}
+
 AuthManager::AuthManager(QObject *parent, bool readonlyMode)
 	: QObject(parent)
 	, _authTable(new AuthTable("", this, readonlyMode))
@@ -18,6 +23,7 @@ AuthManager::AuthManager(QObject *parent, bool readonlyMode)
 	, _authRequired(true)
 	, _timer(new QTimer(this))
 	, _authBlockTimer(new QTimer(this))
+	, _lastUseTimer(new QTimer(this))
 {
 	AuthManager::manager = this;
 
@@ -35,6 +41,10 @@ AuthManager::AuthManager(QObject *parent, bool readonlyMode)
 	_authBlockTimer->setInterval(60000);
 	connect(_authBlockTimer, &QTimer::timeout, this, &AuthManager::checkAuthBlockTimeout);
 
+	// setup lastUseTimer
+	_lastUseTimer->setInterval(LAST_USE_WRITE_INTERVAL_MS);
+	connect(_lastUseTimer, &QTimer::timeout, this, &AuthManager::writeTokenLastUse);
+
 	// init with default user and password
 	if (!_authTable->userExist("Hyperion"))
 	{
@@ -43,6 +53,25 @@ AuthManager::AuthManager(QObject *parent, bool readonlyMode)
 
 	// update Hyperion user token on startup
 	_authTable->setUserToken("Hyperion");
+
+	loadTokenIndex();
+}
+
+AuthManager::~AuthManager()
+{
+	writeTokenLastUse();
+}
+
+void AuthManager::loadTokenIndex()
+{
+	_tokenIndex.clear();
+	for (const auto &entry : _authTable->getTokenHashes())
+	{
+		// user records have no id, their tokens are checked by isUserTokenAuthorized()
+		const QString id = entry["id"].toString();
+		if (!id.isEmpty())
+			_tokenIndex.insert(entry["token"].toByteArray(), id);
+	}
 }
 
 AuthManager::AuthDefinition AuthManager::createToken(const QString &comment)
@@ -51,6 +80,7 @@ AuthManager::AuthDefinition AuthManager::createToken(const QString &comment)
 	const QString id = QUuid::createUuid().toString().mid(1, 36).left(5);
 
 	_authTable->createToken(token, comment, id);
+	loadTokenIndex();
 
 	AuthDefinition def;
 	def.comment = comment;
@@ -70,7 +100,7 @@ QVector<AuthManager::AuthDefinition> AuthManager::getTokenList() const
 		AuthDefinition def;
 		def.comment = entry["comment"].toString();
 		def.id = entry["id"].toString();
-		def.lastUse = entry["last_use"].toString();
+		def.lastUse = _tokenLastUse.value(def.id, entry["last_use"].toString());
 
 		// don't add empty ids
 		if (!entry["id"].toString().isEmpty())
@@ -114,13 +144,18 @@ bool AuthManager::isTokenAuthorized(const QString &token)
 	if (isTokenAuthBlocked())
 		return false;
 
-	if (!_authTable->tokenExist(token))
+	const QString id = _tokenIndex.value(_authTable->hashToken(token));
+	if (id.isEmpty())
 	{
 		setAuthBlock();
 		return false;
 	}
-	// timestamp update
-	tokenChange(getTokenList());
+
+	// timestamp update, written to the database and announced with the next periodic write
+	_tokenLastUse.insert(id, QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+	if (!_lastUseTimer->isActive())
+		_lastUseTimer->start();
+
 	return true;
 }
 
@@ -182,6 +217,7 @@ void AuthManager::handlePendingTokenRequest(const QString &id, bool accept)
 		{
 			const QString token = QUuid::createUuid().toString().remove("{").remove("}");
 			_authTable->createToken(token, def.comment, id);
+			loadTokenIndex();
 			emit tokenResponse(true, def.caller, token, def.comment, id, def.tan);
 			emit tokenChange(getTokenList());
 		}
@@ -220,6 +256,16 @@ bool AuthManager::deleteToken(const QString &id)
 {
 	if (_authTable->deleteToken(id))
 	{
+		// revoke immediately, the index must not outlive the record
+		for (auto it = _tokenIndex.begin(); it != _tokenIndex.end();)
+		{
+			if (it.value() == id)
+				it = _tokenIndex.erase(it);
+			else
+				++it;
+		}
+		_tokenLastUse.remove(id);
+
 		emit tokenChange(getTokenList());
 		return true;
 	}
@@ -284,3 +330,20 @@ void AuthManager::checkAuthBlockTimeout()
 	if (_userAuthAttempts.empty() && _tokenAuthAttempts.empty())
 		_authBlockTimer->stop();
 }
+
+void AuthManager::writeTokenLastUse()
+{
+	_lastUseTimer->stop();
+	if (_tokenLastUse.isEmpty())
+		return;
+
+	_authTable->startTransaction();
+	for (auto it = _tokenLastUse.constBegin(); it != _tokenLastUse.constEnd(); ++it)
+	{
+		_authTable->updateTokenUsed(it.key(), it.value());
+	}
+	_authTable->commitTransaction();
+	_tokenLastUse.clear();
+
+	emit tokenChange(getTokenList());
+}
@@ -14,6 +14,7 @@ const int GrabberWrapper::DEFAULT_RATE_HZ = 25;
 const int GrabberWrapper::DEFAULT_MIN_GRAB_RATE_HZ = 1;
 const int GrabberWrapper::DEFAULT_MAX_GRAB_RATE_HZ = 30;
 const int GrabberWrapper::DEFAULT_PIXELDECIMATION = 8;
+const int GrabberWrapper::UNCHANGED_FRAME_REFRESH_MS = 1000;
 
 /// Map of Hyperion instances with grabber name that requested screen capture
 QMap<int, QString> GrabberWrapper::GRABBER_SYS_CLIENTS = QMap<int, QString>();
@@ -208,6 +209,12 @@ void GrabberWrapper::handleSettingsUpdate(settings::type type, const QJsonDocume
 			// pixel decimation for x11
 			_ggrabber->setPixelDecimation(obj["pixelDecimation"].toInt(DEFAULT_PIXELDECIMATION));
 
+			// grab on screen changes only for x11/xcb
+			_ggrabber->setDamageTracking(obj["damageTracking"].toBool(false));
+
+			// double buffered, asynchronous capture for xcb
+			_ggrabber->setAsyncCapture(obj["asyncCapture"].toBool(false));
+
 			// crop for system capture
 			_ggrabber->setCropping(
 				obj["cropLeft"].toInt(0),
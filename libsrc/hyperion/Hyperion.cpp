@@ -21,6 +21,7 @@
 #include <utils/hyperion.h>
 #include <utils/GlobalSignals.h>
 #include <utils/Logger.h>
+#include <utils/Metrics.h>
 
 // LedDevice includes
 #include <leddevice/LedDeviceWrapper.h>
@@ -45,6 +46,77 @@
 #include <boblightserver/BoblightServer.h>
 #endif
 
+namespace {
+
+/// Grid of pixels sampled for the fingerprint of an image
+const unsigned FINGERPRINT_COLUMNS = 128;
+const unsigned FINGERPRINT_ROWS = 72;
+
+///
+/// Hashes the size and a grid of pixels of an image (FNV-1a). Changes between the sampled pixels are not noticed,
+/// the LED colors average whole areas of the image anyway.
+///
+quint64 imageFingerprint(const Image<ColorRgb>& image)
+{
+	quint64 hash = 14695981039346656037ULL;
+	const auto mix = [&hash](quint64 value) { hash = (hash ^ value) * 1099511628211ULL; };
+
+	const unsigned width = image.width();
+	const unsigned height = image.height();
+	mix(width);
+	mix(height);
+
+	const unsigned stepX = qMax(1u, width / FINGERPRINT_COLUMNS);
+	const unsigned stepY = qMax(1u, height / FINGERPRINT_ROWS);
+	for (unsigned y = stepY / 2; y < height; y += stepY)
+	{
+		const ColorRgb* row = image.memptr() + static_cast<size_t>(y) * width;
+		for (unsigned x = stepX / 2; x < width; x += stepX)
+		{
+			mix((quint64(row[x].red) << 16) | (quint64(row[x].green) << 8) | row[x].blue);
+		}
+	}
+	return hash;
+}
+
+///
+/// Swaps the color channels of each led into the color order of the led
+///
+void reorderColors(std::vector<ColorRgb>& colors, const std::vector<ColorOrder>& colorOrders)
+{
+	const size_t count = qMin(colors.size(), colorOrders.size());
+	for (size_t i = 0; i < count; ++i)
+	{
+		ColorRgb& color = colors[i];
+		switch (colorOrders[i])
+		{
+		case ColorOrder::ORDER_RGB:
+			// leave as it is
+			break;
+		case ColorOrder::ORDER_BGR:
+			std::swap(color.red, color.blue);
+			break;
+		case ColorOrder::ORDER_RBG:
+			std::swap(color.green, color.blue);
+			break;
+		case ColorOrder::ORDER_GRB:
+			std::swap(color.red, color.green);
+			break;
+		case ColorOrder::ORDER_GBR:
+			std::swap(color.red, color.green);
+			std::swap(color.green, color.blue);
+			break;
+
+		case ColorOrder::ORDER_BRG:
+			std::swap(color.red, color.blue);
+			std::swap(color.green, color.blue);
+			break;
+		}
+	}
+}
+
+}
+
 Hyperion::Hyperion(quint8 instance, bool readonlyMode)
 	: QObject()
 	, _instIndex(instance)
@@ -53,7 +125,7 @@ Hyperion::Hyperion(quint8 instance, bool readonlyMode)
 	, _ledString(hyperion::createLedString(getSetting(settings::LEDS).array(), hyperion::createColorOrder(getSetting(settings::DEVICE).object())))
 	, _imageProcessor(nullptr)
 	, _muxer(nullptr)
-	, _raw2ledAdjustment(hyperion::createLedColorsAdjustment(static_cast<int>(_ledString.leds().size()), getSetting(settings::COLOR).object()))
+	, _raw2ledAdjustment(hyperion::createLedColorsAdjustment(static_cast<int>(_ledString.size()), getSetting(settings::COLOR).object()))
 	, _ledDeviceWrapper(nullptr)
 	, _deviceSmooth(nullptr)
 	, _effectEngine(nullptr)
@@ -65,7 +137,9 @@ Hyperion::Hyperion(quint8 instance, bool readonlyMode)
 	, _ledGridSize(hyperion::getLedLayoutGridSize(getSetting(settings::LEDS).array()))
 	, _BGEffectHandler(nullptr)
 	, _captureCont(nullptr)
-	, _ledBuffer(_ledString.leds().size(), ColorRgb::BLACK)
+	, _ledBuffer(_ledString.size(), ColorRgb::BLACK)
+	, _imageFingerprint(0)
+	, _imageFingerprintValid(false)
 #if defined(ENABLE_BOBLIGHT_SERVER)
 	, _boblightServer(nullptr)
 #endif
@@ -78,7 +152,7 @@ Hyperion::Hyperion(quint8 instance, bool readonlyMode)
 
 	_componentRegister = new ComponentRegister(this);
 	_imageProcessor = new ImageProcessor(_ledString, this);
-	_muxer = new PriorityMuxer(static_cast<int>(_ledString.leds().size()), this);
+	_muxer = new PriorityMuxer(static_cast<int>(_ledString.size()), this);
 }
 
 Hyperion::~Hyperion()
@@ -102,12 +176,6 @@ void Hyperion::start()
 	// handle hwLedCount
 	_hwLedCount = getSetting(settings::DEVICE).object()["hardwareLedCount"].toInt(getLedCount());
 
-	// Initialize colororder vector
-	for (const Led& led : _ledString.leds())
-	{
-		_ledStringColorOrder.push_back(led.colorOrder);
-	}
-
 	// connect Hyperion::update with Muxer visible priority changes as muxer updates independent
 	connect(_muxer, &PriorityMuxer::visiblePriorityChanged, this, &Hyperion::update);
 	connect(_muxer, &PriorityMuxer::visiblePriorityChanged, this, &Hyperion::handleSourceAvailability);
@@ -119,6 +187,9 @@ void Hyperion::start()
 	// listen for settings updates of this instance (LEDS & COLOR)
 	connect(_settingsManager, &SettingsManager::settingsChanged, this, &Hyperion::handleSettingsUpdate);
 
+	// component changes, e.g. of the black border detection, apply to the next image even if unchanged
+	connect(this, &Hyperion::compStateChangeRequest, this, [this]() { _imageFingerprintValid = false; });
+
 	#if 0
 	// set color correction activity state
 	const QJsonObject color = getSetting(settings::COLOR).object();
@@ -222,7 +293,7 @@ void Hyperion::handleSettingsUpdate(settings::type type, const QJsonDocument& co
 		const QJsonObject obj = config.object();
 		// change in color recreate ledAdjustments
 		delete _raw2ledAdjustment;
-		_raw2ledAdjustment = hyperion::createLedColorsAdjustment(static_cast<int>(_ledString.leds().size()), obj);
+		_raw2ledAdjustment = hyperion::createLedColorsAdjustment(static_cast<int>(_ledString.size()), obj);
 
 		if (!_raw2ledAdjustment->verifyAdjustments())
 		{
@@ -239,24 +310,18 @@ void Hyperion::handleSettingsUpdate(settings::type type, const QJsonDocument& co
 		// ledstring, img processor, muxer, ledGridSize (effect-engine image based effects), _ledBuffer and ByteOrder of ledstring
 		_ledString = hyperion::createLedString(leds, hyperion::createColorOrder(getSetting(settings::DEVICE).object()));
 		_imageProcessor->setLedString(_ledString);
-		_muxer->updateLedColorsLength(static_cast<int>(_ledString.leds().size()));
+		_muxer->updateLedColorsLength(static_cast<int>(_ledString.size()));
 		_ledGridSize = hyperion::getLedLayoutGridSize(leds);
 
-		std::vector<ColorRgb> color(_ledString.leds().size(), ColorRgb{0,0,0});
+		std::vector<ColorRgb> color(_ledString.size(), ColorRgb{0,0,0});
 		_ledBuffer = color;
 
-		_ledStringColorOrder.clear();
-		for (const Led& led : _ledString.leds())
-		{
-			_ledStringColorOrder.push_back(led.colorOrder);
-		}
-
 		// handle hwLedCount update
 		_hwLedCount = getSetting(settings::DEVICE).object()["hardwareLedCount"].toInt(getLedCount());
 
 		// change in leds are also reflected in adjustment
 		delete _raw2ledAdjustment;
-		_raw2ledAdjustment = hyperion::createLedColorsAdjustment(static_cast<int>(_ledString.leds().size()), getSetting(settings::COLOR).object());
+		_raw2ledAdjustment = hyperion::createLedColorsAdjustment(static_cast<int>(_ledString.size()), getSetting(settings::COLOR).object());
 
 		// start cached effects
 		_effectEngine->startCachedEffects();
@@ -273,12 +338,6 @@ void Hyperion::handleSettingsUpdate(settings::type type, const QJsonDocument& co
 		{
 			_ledString = hyperion::createLedString(getSetting(settings::LEDS).array(), hyperion::createColorOrder(dev));
 			_imageProcessor->setLedString(_ledString);
-
-			_ledStringColorOrder.clear();
-			for (const Led& led : _ledString.leds())
-			{
-				_ledStringColorOrder.push_back(led.colorOrder);
-			}
 		}
 
 		// do always reinit until the led devices can handle dynamic changes
@@ -328,7 +387,7 @@ unsigned Hyperion::updateSmoothingConfig(unsigned id, int settlingTime_ms, doubl
 
 int Hyperion::getLedCount() const
 {
-	return static_cast<int>(_ledString.leds().size());
+	return static_cast<int>(_ledString.size());
 }
 
 void Hyperion::setSourceAutoSelect(bool state)
@@ -403,10 +462,19 @@ bool Hyperion::setInputImage(int priority, const Image<ColorRgb>& image, int64_t
 			_effectEngine->channelCleared(priority);
 		}
 
-		// if this priority is visible, update immediately
+		// if this priority is visible, update immediately. An unchanged image doesn't need to pass the processing
+		// pipeline again, smoothing and device refresh continue on their own timers
 		if(priority == _muxer->getCurrentPriority())
 		{
-			update();
+			const quint64 fingerprint = imageFingerprint(image);
+			if (!_imageFingerprintValid || fingerprint != _imageFingerprint || !_imageProcessor->isSettled())
+			{
+				update();
+
+				// the device might not be ready for the image yet
+				_imageFingerprint = fingerprint;
+				_imageFingerprintValid = _ledDeviceWrapper->enabled();
+			}
 		}
 
 		return true;
@@ -428,7 +496,7 @@ void Hyperion::setColor(int priority, const std::vector<ColorRgb> &ledColors, in
 	}
 
 	// create full led vector from single/multiple colors
-	size_t size = _ledString.leds().size();
+	size_t size = _ledString.size();
 	std::vector<ColorRgb> newLedColors;
 	while (true)
 	{
@@ -561,6 +629,7 @@ void Hyperion::setLedMappingType(int mappingType)
 	if(mappingType != _imageProcessor->getUserLedMappingType())
 	{
 		_imageProcessor->setLedMappingType(mappingType);
+		_imageFingerprintValid = false;
 		emit imageToLedsMappingChanged(mappingType);
 	}
 }
@@ -590,6 +659,7 @@ void Hyperion::handleVisibleComponentChanged(hyperion::Components comp)
 	_imageProcessor->setBlackbarDetectDisable((comp == hyperion::COMP_EFFECT));
 	_imageProcessor->setHardLedMappingType((comp == hyperion::COMP_EFFECT) ? 0 : -1);
 	_raw2ledAdjustment->setBacklightEnabled((comp != hyperion::COMP_COLOR && comp != hyperion::COMP_EFFECT));
+	_imageFingerprintValid = false;
 }
 
 void Hyperion::handleSourceAvailability(const quint8& priority)
@@ -615,6 +685,9 @@ void Hyperion::handleSourceAvailability(const quint8& priority)
 
 void Hyperion::update()
 {
+	// settings, adjustments or priority changes, the next image is processed even if unchanged
+	_imageFingerprintValid = false;
+
 	// Obtain the current priority channel
 	int priority = _muxer->getCurrentPriority();
 	const PriorityMuxer::InputInfo priorityInfo = _muxer->getInputInfo(priority);
@@ -624,6 +697,7 @@ void Hyperion::update()
 	if (image.width() > 1 || image.height() > 1)
 	{
 		emit currentImage(image);
+		Metrics::ScopedTimer timer(Metrics::PROCESS);
 		_ledBuffer = _imageProcessor->process(image);
 	}
 	else
@@ -634,37 +708,16 @@ void Hyperion::update()
 	// emit rawLedColors before transform
 	emit rawLedColors(_ledBuffer);
 
-	_raw2ledAdjustment->applyAdjustment(_ledBuffer);
-
-	int i = 0;
-	for (ColorRgb& color : _ledBuffer)
 	{
-		// correct the color byte order
-		switch (_ledStringColorOrder.at(i))
-		{
-		case ColorOrder::ORDER_RGB:
-			// leave as it is
-			break;
-		case ColorOrder::ORDER_BGR:
-			std::swap(color.red, color.blue);
-			break;
-		case ColorOrder::ORDER_RBG:
-			std::swap(color.green, color.blue);
-			break;
-		case ColorOrder::ORDER_GRB:
-			std::swap(color.red, color.green);
-			break;
-		case ColorOrder::ORDER_GBR:
-			std::swap(color.red, color.green);
-			std::swap(color.green, color.blue);
-			break;
+		Metrics::ScopedTimer timer(Metrics::ADJUST);
+		_raw2ledAdjustment->applyAdjustment(_ledBuffer);
+	}
+	Metrics::count(_instIndex, Metrics::UPDATES);
 
-		case ColorOrder::ORDER_BRG:
-			std::swap(color.red, color.blue);
-			std::swap(color.green, color.blue);
-			break;
-		}
-		i++;
+	// correct the color byte order, the lane is skipped for RGB only layouts
+	if (!_ledString.isRgbOrder())
+	{
+		reorderColors(_ledBuffer, _ledString.colorOrders());
 	}
 
 	// fill additional hardware LEDs with black
@@ -3,6 +3,7 @@
 // hyperion
 #include <hyperion/Hyperion.h>
 #include <db/InstanceTable.h>
+#include <blackborder/BlackBorderCache.h>
 
 // qt
 #include <QThread>
@@ -200,6 +201,7 @@ void HyperionIManager::handleFinished()
 	Info(_log,"Hyperion instance '%s' has been stopped", QSTRING_CSTR(_instanceTable->getNamebyIndex(instance)));
 
 	_runningInstances.remove(instance);
+	updateSharedProcessing();
 	hyperion->thread()->deleteLater();
 	hyperion->deleteLater();
 	emit instanceStateChanged(InstanceState::H_STOPPED, instance);
@@ -215,6 +217,7 @@ void HyperionIManager::handleStarted()
 
 	_startQueue.removeAll(instance);
 	_runningInstances.insert(instance, hyperion);
+	updateSharedProcessing();
 	emit instanceStateChanged(InstanceState::H_STARTED, instance);
 	emit change();
 
@@ -225,3 +228,14 @@ void HyperionIManager::handleStarted()
 		_pendingRequests.remove(instance);
 	}
 }
+
+void HyperionIManager::updateSharedProcessing()
+{
+	// captured frames are analysed once for all instances, which only pays off with multiple instances
+	const bool share = _runningInstances.size() > 1;
+	if (hyperion::BlackBorderCache::getInstance()->isEnabled() != share)
+	{
+		Debug(_log, "%s shared capture processing for %d running instances", share ? "Enable" : "Disable", _runningInstances.size());
+		hyperion::BlackBorderCache::getInstance()->setEnabled(share);
+	}
+}
@@ -7,8 +7,60 @@
 // Blacborder includes
 #include <blackborder/BlackBorderProcessor.h>
 
+// qt
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <atomic>
+
 using namespace hyperion;
 
+/// Number of mappings kept to switch between recently used geometries (e.g. letterbox states) without a rebuild
+static const int MAPPING_CACHE_SIZE = 4;
+
+///
+/// A mapping which is built by the global thread pool, as its construction is too costly for the frame processing
+///
+struct ImageProcessor::PendingMapping
+{
+	class Builder : public QRunnable
+	{
+	public:
+		explicit Builder(const QSharedPointer<PendingMapping>& pending)
+			: _pending(pending)
+		{
+		}
+
+		void run() override
+		{
+			_pending->map = QSharedPointer<ImageToLedsMap>::create(_pending->width, _pending->height, _pending->horizontalBorder, _pending->verticalBorder, _pending->leds);
+			_pending->finished = true;
+		}
+
+	private:
+		QSharedPointer<PendingMapping> _pending;
+	};
+
+	PendingMapping(unsigned width_, unsigned height_, unsigned horizontalBorder_, unsigned verticalBorder_, const LedString& leds_)
+		: width(width_)
+		, height(height_)
+		, horizontalBorder(horizontalBorder_)
+		, verticalBorder(verticalBorder_)
+		, leds(leds_)
+		, finished(false)
+	{
+	}
+
+	const unsigned width;
+	const unsigned height;
+	const unsigned horizontalBorder;
+	const unsigned verticalBorder;
+	/// copy of the led layout, the builder must not access the processor
+	const LedString leds;
+	QSharedPointer<ImageToLedsMap> map;
+	std::atomic<bool> finished;
+};
+
 // global transform method
 int ImageProcessor::mappingTypeToInt(const QString& mappingType)
 {
@@ -31,7 +83,11 @@ ImageProcessor::ImageProcessor(const LedString& ledString, Hyperion* hyperion)
 	, _log(nullptr)
 	, _ledString(ledString)
 	, _borderProcessor(new BlackBorderProcessor(hyperion, this))
-	, _imageToLeds(nullptr)
+	, _imageToLeds()
+	, _mappingCache()
+	, _pendingMapping()
+	, _requestedHorizontalBorder(0)
+	, _requestedVerticalBorder(0)
 	, _mappingType(0)
 	, _userMappingType(0)
 	, _hardMappingType(0)
@@ -48,7 +104,6 @@ ImageProcessor::ImageProcessor(const LedString& ledString, Hyperion* hyperion)
 
 ImageProcessor::~ImageProcessor()
 {
-	delete _imageToLeds;
 }
 
 void ImageProcessor::handleSettingsUpdate(settings::type type, const QJsonDocument& config)
@@ -72,16 +127,29 @@ void ImageProcessor::setSize(unsigned width, unsigned height)
 		return;
 	}
 
-	// Clean up the old buffer and mapping
-	delete _imageToLeds;
+	// a mapping for another size can't be used meanwhile, the new one is required immediately
+	_pendingMapping.clear();
+	_requestedHorizontalBorder = 0;
+	_requestedVerticalBorder = 0;
 
-	// Construct a new buffer and mapping
-	_imageToLeds = (width>0 && height>0) ? (new ImageToLedsMap(width, height, 0, 0, _ledString.leds())) : nullptr;
+	if (width>0 && height>0)
+	{
+		_imageToLeds = findMapping(width, height, 0, 0);
+		if (!_imageToLeds)
+		{
+			_imageToLeds = QSharedPointer<ImageToLedsMap>::create(width, height, 0, 0, _ledString);
+			cacheMapping(_imageToLeds);
+		}
+	}
+	else
+	{
+		_imageToLeds.clear();
+	}
 }
 
 void ImageProcessor::setLedString(const LedString& ledString)
 {
-	if ( _imageToLeds != nullptr)
+	if (!_imageToLeds.isNull())
 	{
 		_ledString = ledString;
 
@@ -89,14 +157,90 @@ void ImageProcessor::setLedString(const LedString& ledString)
 		unsigned width = _imageToLeds->width();
 		unsigned height = _imageToLeds->height();
 
-		// Clean up the old buffer and mapping
-		delete _imageToLeds;
+		// all mappings are based on the old led layout
+		clearMappings();
+		_requestedHorizontalBorder = 0;
+		_requestedVerticalBorder = 0;
 
 		// Construct a new buffer and mapping
-		_imageToLeds = new ImageToLedsMap(width, height, 0, 0, _ledString.leds());
+		_imageToLeds = QSharedPointer<ImageToLedsMap>::create(width, height, 0, 0, _ledString);
+		cacheMapping(_imageToLeds);
+	}
+}
+
+QSharedPointer<ImageToLedsMap> ImageProcessor::findMapping(unsigned width, unsigned height, unsigned horizontalBorder, unsigned verticalBorder)
+{
+	for (int i = 0; i < _mappingCache.size(); ++i)
+	{
+		const QSharedPointer<ImageToLedsMap>& map = _mappingCache.at(i);
+		if (map->width() == width && map->height() == height && map->horizontalBorder() == horizontalBorder && map->verticalBorder() == verticalBorder)
+		{
+			_mappingCache.move(i, 0);
+			return _mappingCache.first();
+		}
+	}
+	return QSharedPointer<ImageToLedsMap>();
+}
+
+void ImageProcessor::requestMapping(unsigned width, unsigned height, unsigned horizontalBorder, unsigned verticalBorder)
+{
+	_requestedHorizontalBorder = horizontalBorder;
+	_requestedVerticalBorder = verticalBorder;
+
+	// the mapping in use matches already
+	if (_imageToLeds && _imageToLeds->width() == width && _imageToLeds->height() == height
+		&& _imageToLeds->horizontalBorder() == horizontalBorder && _imageToLeds->verticalBorder() == verticalBorder)
+	{
+		_pendingMapping.clear();
+		return;
+	}
+
+	// the mapping is under construction already
+	if (_pendingMapping && _pendingMapping->width == width && _pendingMapping->height == height
+		&& _pendingMapping->horizontalBorder == horizontalBorder && _pendingMapping->verticalBorder == verticalBorder)
+	{
+		return;
+	}
+	_pendingMapping.clear();
+
+	QSharedPointer<ImageToLedsMap> map = findMapping(width, height, horizontalBorder, verticalBorder);
+	if (map)
+	{
+		_imageToLeds = map;
+		return;
+	}
+
+	// keep the current mapping until the new one is built
+	_pendingMapping = QSharedPointer<PendingMapping>::create(width, height, horizontalBorder, verticalBorder, _ledString);
+	QThreadPool::globalInstance()->start(new PendingMapping::Builder(_pendingMapping));
+}
+
+void ImageProcessor::takePendingMapping()
+{
+	// outdated builds are dropped on request, a finished build is always the requested one
+	if (_pendingMapping && _pendingMapping->finished)
+	{
+		_imageToLeds = _pendingMapping->map;
+		cacheMapping(_imageToLeds);
+		_pendingMapping.clear();
 	}
 }
 
+void ImageProcessor::cacheMapping(const QSharedPointer<ImageToLedsMap>& map)
+{
+	_mappingCache.prepend(map);
+	while (_mappingCache.size() > MAPPING_CACHE_SIZE)
+	{
+		_mappingCache.removeLast();
+	}
+}
+
+void ImageProcessor::clearMappings()
+{
+	_mappingCache.clear();
+	_pendingMapping.clear();
+}
+
 void ImageProcessor::setBlackbarDetectDisable(bool enable)
 {
 	_borderProcessor->setHardDisable(enable);
@@ -107,6 +251,21 @@ bool ImageProcessor::blackBorderDetectorEnabled() const
 	return _borderProcessor->enabled();
 }
 
+bool ImageProcessor::isSettled() const
+{
+	if (!_pendingMapping.isNull())
+	{
+		return false;
+	}
+
+	if (!_borderProcessor->enabled())
+	{
+		return _requestedHorizontalBorder == 0 && _requestedVerticalBorder == 0;
+	}
+
+	return _borderProcessor->isSettled();
+}
+
 void ImageProcessor::setLedMappingType(int mapType)
 {
 	// if the _hardMappingType is >-1 we aren't allowed to overwrite it
@@ -130,9 +289,9 @@ void ImageProcessor::setHardLedMappingType(int mapType)
 
 bool ImageProcessor::getScanParameters(size_t led, double &hscanBegin, double &hscanEnd, double &vscanBegin, double &vscanEnd) const
 {
-	if (led < _ledString.leds().size())
+	if (led < _ledString.size())
 	{
-		const Led & l = _ledString.leds()[led];
+		const Led l = _ledString.led(led);
 		hscanBegin = l.minX_frac;
 		hscanEnd = l.maxX_frac;
 		vscanBegin = l.minY_frac;
@@ -5,12 +5,86 @@
 // hyperion includes
 #include <hyperion/LedString.h>
 
-std::vector<Led>& LedString::leds()
+namespace {
+
+inline uint16_t toFixedPoint(double fraction)
+{
+	return static_cast<uint16_t>(qRound(qMax(0.0, qMin(1.0, fraction)) * LedString::FRACTION_ONE));
+}
+
+inline double toFraction(uint16_t value)
+{
+	return static_cast<double>(value) / LedString::FRACTION_ONE;
+}
+
+/// Scales a fixed-point fraction to a pixel index, rounding to the nearest pixel
+inline unsigned toPixel(unsigned size, uint16_t value)
+{
+	return (size * value + LedString::FRACTION_ONE / 2) / LedString::FRACTION_ONE;
+}
+
+}
+
+void LedString::append(const Led& led)
+{
+	_minX.push_back(toFixedPoint(led.minX_frac));
+	_maxX.push_back(toFixedPoint(led.maxX_frac));
+	_minY.push_back(toFixedPoint(led.minY_frac));
+	_maxY.push_back(toFixedPoint(led.maxY_frac));
+	_colorOrders.push_back(led.colorOrder);
+	_rgbOrder = _rgbOrder && led.colorOrder == ColorOrder::ORDER_RGB;
+}
+
+Led LedString::led(size_t index) const
 {
-	return mLeds;
+	Led led;
+	led.minX_frac = toFraction(_minX[index]);
+	led.maxX_frac = toFraction(_maxX[index]);
+	led.minY_frac = toFraction(_minY[index]);
+	led.maxY_frac = toFraction(_maxY[index]);
+	led.colorOrder = _colorOrders[index];
+	return led;
 }
 
-const std::vector<Led>& LedString::leds() const
+std::vector<LedString::PixelBounds> LedString::pixelBounds(unsigned width, unsigned height, unsigned horizontalBorder, unsigned verticalBorder) const
 {
-	return mLeds;
+	std::vector<PixelBounds> bounds(size(), PixelBounds{0, 0, 0, 0});
+
+	const unsigned xOffset      = verticalBorder;
+	const unsigned actualWidth  = width  - 2 * verticalBorder;
+	const unsigned yOffset      = horizontalBorder;
+	const unsigned actualHeight = height - 2 * horizontalBorder;
+
+	for (size_t i = 0; i < bounds.size(); ++i)
+	{
+		// skip leds without area
+		if (_minX[i] == _maxX[i] || _minY[i] == _maxY[i])
+		{
+			continue;
+		}
+
+		// Compute the index boundaries for this led
+		unsigned minX_idx = xOffset + toPixel(actualWidth,  _minX[i]);
+		unsigned maxX_idx = xOffset + toPixel(actualWidth,  _maxX[i]);
+		unsigned minY_idx = yOffset + toPixel(actualHeight, _minY[i]);
+		unsigned maxY_idx = yOffset + toPixel(actualHeight, _maxY[i]);
+
+		// make sure that the area is at least a single pixel large
+		minX_idx = qMin(minX_idx, xOffset + actualWidth - 1);
+		if (minX_idx == maxX_idx)
+		{
+			maxX_idx++;
+		}
+		minY_idx = qMin(minY_idx, yOffset + actualHeight - 1);
+		if (minY_idx == maxY_idx)
+		{
+			maxY_idx++;
+		}
+
+		bounds[i].minX = static_cast<uint16_t>(minX_idx);
+		bounds[i].maxX = static_cast<uint16_t>(qMin(maxX_idx, xOffset + actualWidth));
+		bounds[i].minY = static_cast<uint16_t>(minY_idx);
+		bounds[i].maxY = static_cast<uint16_t>(qMin(maxY_idx, yOffset + actualHeight));
+	}
+	return bounds;
 }
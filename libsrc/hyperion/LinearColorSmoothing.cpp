@@ -4,6 +4,7 @@
 
 #include "LinearColorSmoothing.h"
 #include <hyperion/Hyperion.h>
+#include <utils/Metrics.h>
 
 #include <cmath>
 #include <chrono>
@@ -435,6 +436,7 @@ void LinearColorSmoothing::performLinear(const int64_t now) {
 
 void LinearColorSmoothing::updateLeds()
 {
+	Metrics::ScopedTimer timer(Metrics::SMOOTHING);
 	const int64_t now = micros();
 	const int64_t deltaTime = _targetTime - now;
 
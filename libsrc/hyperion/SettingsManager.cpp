@@ -17,11 +17,20 @@
 
 #include <utils/version.hpp>
 
+#include <QMutex>
+#include <QMutexLocker>
+
 using namespace semver;
 
 // Constants
 namespace {
 const char DEFAULT_VERSION[] = "2.0.0-alpha.8";
+
+/// Guards the settings stores, settings are read and saved from the API threads as well
+QMutex settingsMutex;
+
+/// Parsed global settings, shared by all instances
+QHash<QString, QJsonDocument> globalSettings;
 } //End of constants
 
 QJsonObject SettingsManager::schemaJson;
@@ -36,6 +45,7 @@ SettingsManager::SettingsManager(quint8 instance, QObject* parent, bool readonly
 	  , _readonlyMode(readonlyMode)
 {
 	_sTable->setReadonlyMode(_readonlyMode);
+
 	// get schema
 	if (schemaJson.isEmpty())
 	{
@@ -88,7 +98,7 @@ SettingsManager::SettingsManager(quint8 instance, QObject* parent, bool readonly
 	QJsonObject dbConfig;
 	for (const auto& key : qAsConst(keyList))
 	{
-		QJsonDocument doc = _sTable->getSettingsRecord(key);
+		QJsonDocument doc = cachedSetting(key);
 		if (doc.isArray())
 		{
 			dbConfig[key] = doc.array();
@@ -188,7 +198,45 @@ SettingsManager::SettingsManager(quint8 instance, QObject* parent, bool readonly
 
 QJsonDocument SettingsManager::getSetting(settings::type type) const
 {
-	return _sTable->getSettingsRecord(settings::typeToString(type));
+	return cachedSetting(settings::typeToString(type));
+}
+
+QJsonDocument SettingsManager::cachedSetting(const QString& key) const
+{
+	QMutexLocker lock(&settingsMutex);
+	QHash<QString, QJsonDocument>& store = _sTable->isSettingGlobal(key) ? globalSettings : _settings;
+	auto it = store.constFind(key);
+	if (it == store.constEnd())
+	{
+		it = store.insert(key, _sTable->getSettingsRecord(key));
+	}
+	return it.value();
+}
+
+void SettingsManager::storeSetting(const QString& key, const QJsonDocument& doc) const
+{
+	QMutexLocker lock(&settingsMutex);
+	QHash<QString, QJsonDocument>& store = _sTable->isSettingGlobal(key) ? globalSettings : _settings;
+	store.insert(key, doc);
+}
+
+bool SettingsManager::writeSettings(const QMap<QString, QJsonDocument>& changes)
+{
+	if (!_sTable->startTransaction())
+	{
+		return false;
+	}
+
+	for (auto it = changes.constBegin(); it != changes.constEnd(); ++it)
+	{
+		if (!_sTable->createSettingsRecord(it.key(), QString(it.value().toJson(QJsonDocument::Compact))))
+		{
+			Error(_log, "Failed to write settings of type '%s'", QSTRING_CSTR(it.key()));
+			_sTable->rollbackTransaction();
+			return false;
+		}
+	}
+	return _sTable->commitTransaction();
 }
 
 QJsonObject SettingsManager::getSettings() const
@@ -196,8 +244,8 @@ QJsonObject SettingsManager::getSettings() const
 	QJsonObject config;
 	for (const auto& key : _qconfig.keys())
 	{
-		//Read all records from database to ensure that global settings are read across instances
-		QJsonDocument doc = _sTable->getSettingsRecord(key);
+		// global settings are shared across instances
+		QJsonDocument doc = cachedSetting(key);
 		if (doc.isArray())
 		{
 			config.insert(key, doc.array());
@@ -238,41 +286,52 @@ bool SettingsManager::saveSettings(QJsonObject config, bool correct)
 		}
 	}
 
-	// store the new config
-	_qconfig = config;
-
-	// extract keys and data
-	QStringList keyList = config.keys();
-	QStringList newValueList;
-	for (const auto& key : qAsConst(keyList))
+	bool rc = true;
+	QMap<QString, QJsonDocument> changes;
+	// compare the stored data with new data to save/emit changes accordingly
+	for (auto it = config.constBegin(); it != config.constEnd(); ++it)
 	{
-		if (config[key].isObject())
+		QJsonDocument doc;
+		if (it.value().isObject())
 		{
-			newValueList << QString(QJsonDocument(config[key].toObject()).toJson(QJsonDocument::Compact));
+			doc = QJsonDocument(it.value().toObject());
 		}
-		else if (config[key].isArray())
+		else if (it.value().isArray())
 		{
-			newValueList << QString(QJsonDocument(config[key].toArray()).toJson(QJsonDocument::Compact));
+			doc = QJsonDocument(it.value().toArray());
+		}
+		else
+		{
+			continue;
 		}
-	}
 
-	bool rc = true;
-	// compare database data with new data to emit/save changes accordingly
-	for (const auto& key : qAsConst(keyList))
-	{
-		QString data = newValueList.takeFirst();
-		if (_sTable->getSettingsRecordString(key) != data)
+		if (cachedSetting(it.key()) != doc)
 		{
-			if (!_sTable->createSettingsRecord(key, data))
+			if (_readonlyMode)
 			{
 				rc = false;
+				continue;
 			}
-			else
-			{
-				emit settingsChanged(settings::stringToType(key), QJsonDocument::fromJson(data.toLocal8Bit()));
-			}
+
+			changes.insert(it.key(), doc);
 		}
 	}
+
+	// all changes are written in one transaction, nothing is applied if it fails
+	if (!changes.isEmpty() && !writeSettings(changes))
+	{
+		Error(_log, "Failed to save configuration to the database");
+		return false;
+	}
+
+	// store the new config
+	_qconfig = config;
+
+	for (auto it = changes.constBegin(); it != changes.constEnd(); ++it)
+	{
+		storeSetting(it.key(), it.value());
+		emit settingsChanged(settings::stringToType(it.key()), it.value());
+	}
 	return rc;
 }
 
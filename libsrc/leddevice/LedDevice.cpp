@@ -10,6 +10,7 @@
 #include <QDateTime>
 
 #include "hyperion/Hyperion.h"
+#include <utils/Metrics.h>
 #include <utils/JsonUtils.h>
 
 //std includes
@@ -20,6 +21,7 @@ LedDevice::LedDevice(const QJsonObject& deviceConfig, QObject* parent)
 	: QObject(parent)
 	  , _devConfig(deviceConfig)
 	  , _log(Logger::getInstance("LEDDEVICE"))
+	  , _instance(0)
 	  , _ledBuffer(0)
 	  , _refreshTimer(nullptr)
 	  , _refreshTimerInterval_ms(0)
@@ -156,6 +158,23 @@ bool LedDevice::init(const QJsonObject &deviceConfig)
 	return true;
 }
 
+bool LedDevice::initWhiteAlgorithm(const QJsonObject &deviceConfig)
+{
+	QString whiteAlgorithm = deviceConfig["whiteAlgorithm"].toString("white_off");
+
+	RGBW::WhiteAlgorithm algorithm = RGBW::stringToWhiteAlgorithm(whiteAlgorithm);
+	if (algorithm == RGBW::WhiteAlgorithm::INVALID)
+	{
+		QString errortext = QString ("unknown whiteAlgorithm: %1").arg(whiteAlgorithm);
+		this->setInError(errortext);
+		return false;
+	}
+
+	Debug( _log, "whiteAlgorithm : %s", QSTRING_CSTR(whiteAlgorithm));
+	_rgbwConverter.setAlgorithm(algorithm);
+	return true;
+}
+
 void LedDevice::startRefreshTimer()
 {
 	if ( _isDeviceReady && _isEnabled )
@@ -186,7 +205,14 @@ int LedDevice::updateLeds(const std::vector<ColorRgb>& ledValues)
 		if (_latchTime_ms == 0 || elapsedTimeMs >= _latchTime_ms)
 		{
 			//std::cout << "LedDevice::updateLeds(), Elapsed time since last write (" << elapsedTimeMs << ") ms > _latchTime_ms (" << _latchTime_ms << ") ms" << std::endl;
-			retval = write(ledValues);
+			{
+				Metrics::ScopedTimer timer(Metrics::WRITE);
+				retval = write(ledValues);
+			}
+			if (retval >= 0)
+			{
+				Metrics::count(_instance, Metrics::WRITES);
+			}
 			_lastWriteTime = QDateTime::currentDateTime();
 
 			// if device requires refreshing, save Led-Values and restart the timer
@@ -199,6 +225,7 @@ int LedDevice::updateLeds(const std::vector<ColorRgb>& ledValues)
 		else
 		{
 			//std::cout << "LedDevice::updateLeds(), Skip write. elapsedTime (" << elapsedTimeMs << ") ms < _latchTime_ms (" << _latchTime_ms << ") ms" << std::endl;
+			Metrics::count(_instance, Metrics::DROPPED);
 			if ( _isRefreshEnabled )
 			{
 				//Stop timer to allow for next non-refresh update
@@ -59,6 +59,7 @@ void LedDeviceWrapper::createLedDevice(const QJsonObject& config)
 
 	QString subComponent = parent()->property("instance").toString();
 	_ledDevice->setLogger(Logger::getInstance("LEDDEVICE", subComponent));
+	_ledDevice->setInstance(_hyperion->getInstanceIndex());
 
 	_ledDevice->moveToThread(thread);
 	// setup thread management
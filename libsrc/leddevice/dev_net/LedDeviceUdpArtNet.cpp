@@ -32,8 +32,22 @@ bool LedDeviceUdpArtNet::init(const QJsonObject &deviceConfig)
 	{
 		_artnet_universe = deviceConfig["universe"].toInt(1);
 		_artnet_channelsPerFixture = deviceConfig["channelsPerFixture"].toInt(3);
+		_isRgbw = deviceConfig["rgbw"].toBool(false);
 
-		isInitOK = true;
+		if ( _isRgbw )
+		{
+			if ( _artnet_channelsPerFixture < static_cast<int>(sizeof(ColorRgbw)) )
+			{
+				Warning( _log, "RGBW requires %d channels per fixture, %d configured", static_cast<int>(sizeof(ColorRgbw)), _artnet_channelsPerFixture);
+				_artnet_channelsPerFixture = sizeof(ColorRgbw);
+			}
+			_ledBuffer.resize(_ledRGBWCount);
+			isInitOK = initWhiteAlgorithm(deviceConfig);
+		}
+		else
+		{
+			isInitOK = true;
+		}
 	}
 	return isInitOK;
 }
@@ -64,6 +78,16 @@ int LedDeviceUdpArtNet::write(const std::vector<ColorRgb> &ledValues)
 	int retVal            = 0;
 	int thisUniverse	= _artnet_universe;
 	const uint8_t * rawdata = reinterpret_cast<const uint8_t *>(ledValues.data());
+	unsigned int rawCount = _ledRGBCount;
+	int bytesPerLed = sizeof(ColorRgb);
+
+	if (_isRgbw)
+	{
+		_rgbwConverter.convert(ledValues.data(), qMin(ledValues.size(), static_cast<size_t>(_ledCount)), _ledBuffer.data());
+		rawdata = _ledBuffer.data();
+		rawCount = _ledRGBWCount;
+		bytesPerLed = sizeof(ColorRgbw);
+	}
 
 /*
 This field is incremented in the range 0x01 to 0xff to allow the receiving node to resequence packets.
@@ -77,17 +101,17 @@ The Sequence field is set to 0x00 to disable this feature.
 	int dmxIdx = 0;			// offset into the current dmx packet
 
 	memset(artnet_packet.raw, 0, sizeof(artnet_packet.raw));
-	for (unsigned int ledIdx = 0; ledIdx < _ledRGBCount; ledIdx++)
+	for (unsigned int ledIdx = 0; ledIdx < rawCount; ledIdx++)
 	{
 
 		artnet_packet.Data[dmxIdx++] = rawdata[ledIdx];
-		if ( (ledIdx % 3 == 2) && (ledIdx > 0) )
+		if ( (ledIdx % bytesPerLed == static_cast<unsigned int>(bytesPerLed - 1)) && (ledIdx > 0) )
 		{
-			dmxIdx += (_artnet_channelsPerFixture-3);
+			dmxIdx += (_artnet_channelsPerFixture-bytesPerLed);
 		}
 
 //     is this the   last byte of last packet   ||   last byte of other packets
-		if ( (ledIdx == _ledRGBCount-1) || (dmxIdx >= DMX_MAX) )
+		if ( (ledIdx == rawCount-1) || (dmxIdx >= DMX_MAX) )
 		{
 			prepare(thisUniverse, _artnet_seq, dmxIdx);
 			retVal &= writeBytes(18 + qMin(dmxIdx, DMX_MAX), artnet_packet.raw);
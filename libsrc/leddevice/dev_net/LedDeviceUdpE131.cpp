@@ -44,6 +44,7 @@ bool LedDeviceUdpE131::init(const QJsonObject &deviceConfig)
 	if ( ProviderUdp::init(deviceConfig) )
 	{
 		_e131_universe = deviceConfig["universe"].toInt(1);
+		_isRgbw = deviceConfig["rgbw"].toBool(false);
 		_e131_source_name = deviceConfig["source-name"].toString("hyperion on "+QHostInfo::localHostName());
 		QString _json_cid = deviceConfig["cid"].toString("");
 
@@ -66,6 +67,11 @@ bool LedDeviceUdpE131::init(const QJsonObject &deviceConfig)
 				this->setInError("CID configured is not a valid UUID. Format expected is \"xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx\"");
 			}
 		}
+
+		if ( isInitOK && _isRgbw )
+		{
+			isInitOK = initWhiteAlgorithm(deviceConfig);
+		}
 	}
 	return isInitOK;
 }
@@ -107,6 +113,11 @@ void LedDeviceUdpE131::prepare(unsigned this_universe, unsigned this_dmxChannelC
 
 int LedDeviceUdpE131::write(const std::vector<ColorRgb> &ledValues)
 {
+	if (_isRgbw)
+	{
+		return writeRgbw(ledValues);
+	}
+
 	int retVal            = 0;
 	int thisChannelCount = 0;
 	int dmxChannelCount  = _ledRGBCount;
@@ -145,3 +156,29 @@ int LedDeviceUdpE131::write(const std::vector<ColorRgb> &ledValues)
 
 	return retVal;
 }
+
+int LedDeviceUdpE131::writeRgbw(const std::vector<ColorRgb> &ledValues)
+{
+	int retVal = 0;
+	// RGBW LEDs do not span universes
+	const int ledsPerUniverse = DMX_MAX / static_cast<int>(sizeof(ColorRgbw));
+	const int ledCount = qMin(static_cast<int>(ledValues.size()), static_cast<int>(_ledCount));
+
+	_e131_seq++;
+
+	for (int ledIdx = 0; ledIdx < ledCount; ledIdx += ledsPerUniverse)
+	{
+		const int thisLedCount = qMin(ledsPerUniverse, ledCount - ledIdx);
+		const int thisChannelCount = thisLedCount * static_cast<int>(sizeof(ColorRgbw));
+
+		prepare(_e131_universe + ledIdx / ledsPerUniverse, thisChannelCount);
+		e131_packet.sequence_number = _e131_seq;
+
+		// convert straight into the packet, behind the start code
+		_rgbwConverter.convert(ledValues.data() + ledIdx, static_cast<size_t>(thisLedCount), e131_packet.property_values + 1);
+
+		retVal &= writeBytes(E131_DMP_DATA + 1 + thisChannelCount, e131_packet.raw);
+	}
+
+	return retVal;
+}
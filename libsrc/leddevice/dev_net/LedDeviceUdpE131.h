@@ -122,6 +122,14 @@ private:
 	///
 	int write(const std::vector<ColorRgb> & ledValues) override;
 
+	///
+	/// @brief Writes the RGB-Color values as RGBW to the LEDs, 128 LEDs per universe.
+	///
+	/// @param[in] ledValues The RGB-color per LED
+	/// @return Zero on success, else negative
+	///
+	int writeRgbw(const std::vector<ColorRgb> & ledValues);
+
 	///
 	/// @brief Generate E1.31 communication header
 	///
@@ -133,6 +141,7 @@ private:
 	uint8_t _acn_id[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00 };
 	QString _e131_source_name;
 	QUuid _e131_cid;
+	bool _isRgbw = false;
 };
 
 #endif // LEDEVICEUDPE131_H
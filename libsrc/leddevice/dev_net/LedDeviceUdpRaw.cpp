@@ -34,9 +34,13 @@ bool LedDeviceUdpRaw::init(const QJsonObject &deviceConfig)
 		Debug(_log, "ColorOrder   : %s", QSTRING_CSTR( this->getColorOrder() ));
 		Debug(_log, "LatchTime    : %d", this->getLatchTime());
 
-		if (configuredLedCount > UDP_MAX_LED_NUM)
+		_isRgbw = deviceConfig["rgbw"].toBool(false);
+		// the datagram size limits the number of LEDs
+		const int maxLedCount = _isRgbw ? UDP_MAX_LED_NUM * static_cast<int>(sizeof(ColorRgb)) / static_cast<int>(sizeof(ColorRgbw)) : UDP_MAX_LED_NUM;
+
+		if (configuredLedCount > maxLedCount)
 		{
-			QString errorReason = QString("Device type %1 can only be run with maximum %2 LEDs!").arg(this->getActiveDeviceType()).arg(UDP_MAX_LED_NUM);
+			QString errorReason = QString("Device type %1 can only be run with maximum %2 LEDs!").arg(this->getActiveDeviceType()).arg(maxLedCount);
 			this->setInError ( errorReason );
 			isInitOK = false;
 		}
@@ -44,6 +48,12 @@ bool LedDeviceUdpRaw::init(const QJsonObject &deviceConfig)
 		{
 			// Initialise sub-class
 			isInitOK = ProviderUdp::init(deviceConfig);
+
+			if ( isInitOK && _isRgbw )
+			{
+				_ledBuffer.resize(_ledRGBWCount);
+				isInitOK = initWhiteAlgorithm(deviceConfig);
+			}
 		}
 	}
 	return isInitOK;
@@ -51,6 +61,12 @@ bool LedDeviceUdpRaw::init(const QJsonObject &deviceConfig)
 
 int LedDeviceUdpRaw::write(const std::vector<ColorRgb> &ledValues)
 {
+	if (_isRgbw)
+	{
+		_rgbwConverter.convert(ledValues.data(), qMin(ledValues.size(), static_cast<size_t>(_ledCount)), _ledBuffer.data());
+		return writeBytes(_ledRGBWCount, _ledBuffer.data());
+	}
+
 	const uint8_t * dataPtr = reinterpret_cast<const uint8_t *>(ledValues.data());
 
 	return writeBytes(_ledRGBCount, dataPtr);
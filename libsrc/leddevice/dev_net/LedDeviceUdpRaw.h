@@ -51,6 +51,10 @@ protected:
 	/// @return Zero on success, else negative
 	///
 	int write(const std::vector<ColorRgb> & ledValues) override;
+
+private:
+
+	bool _isRgbw = false;
 };
 
 #endif // LEDEVICEUDPRAW_H
@@ -27,49 +27,38 @@ bool LedDeviceWS281x::init(const QJsonObject &deviceConfig)
 	bool isInitOK = false;
 
 	// Initialise sub-class
-	if ( LedDevice::init(deviceConfig) )
+	if ( LedDevice::init(deviceConfig) && initWhiteAlgorithm(deviceConfig) )
 	{
-		QString whiteAlgorithm = deviceConfig["whiteAlgorithm"].toString("white_off");
-
-		_whiteAlgorithm	= RGBW::stringToWhiteAlgorithm(whiteAlgorithm);
-		if (_whiteAlgorithm == RGBW::WhiteAlgorithm::INVALID)
+		_channel = deviceConfig["pwmchannel"].toInt(0);
+		if (_channel != 0 && _channel != 1)
 		{
-			errortext = QString ("unknown whiteAlgorithm: %1").arg(whiteAlgorithm);
+			errortext = "WS281x: invalid PWM channel; must be 0 or 1.";
 			isInitOK = false;
 		}
 		else
 		{
-			_channel = deviceConfig["pwmchannel"].toInt(0);
-			if (_channel != 0 && _channel != 1)
-			{
-				errortext = "WS281x: invalid PWM channel; must be 0 or 1.";
-				isInitOK = false;
-			}
-			else
-			{
-				memset(&_led_string, 0, sizeof(_led_string));
-				_led_string.freq   = deviceConfig["freq"].toInt(800000UL);
-				_led_string.dmanum = deviceConfig["dma"].toInt(5);
-				_led_string.channel[_channel].gpionum    = deviceConfig["gpio"].toInt(18);
-				_led_string.channel[_channel].count      = deviceConfig["leds"].toInt(256);
-				_led_string.channel[_channel].invert     = deviceConfig["invert"].toInt(0);
-				_led_string.channel[_channel].strip_type = (deviceConfig["rgbw"].toBool(false) ? SK6812_STRIP_GRBW : WS2811_STRIP_RGB);
-				_led_string.channel[_channel].brightness = 255;
-
-				_led_string.channel[!_channel].gpionum = 0;
-				_led_string.channel[!_channel].invert = _led_string.channel[_channel].invert;
-				_led_string.channel[!_channel].count = 0;
-				_led_string.channel[!_channel].brightness = 0;
-				_led_string.channel[!_channel].strip_type = WS2811_STRIP_RGB;
-
-				Debug( _log, "ws281x strip type : %d", _led_string.channel[_channel].strip_type );
-
-				isInitOK = true;
-			}
+			memset(&_led_string, 0, sizeof(_led_string));
+			_led_string.freq   = deviceConfig["freq"].toInt(800000UL);
+			_led_string.dmanum = deviceConfig["dma"].toInt(5);
+			_led_string.channel[_channel].gpionum    = deviceConfig["gpio"].toInt(18);
+			_led_string.channel[_channel].count      = deviceConfig["leds"].toInt(256);
+			_led_string.channel[_channel].invert     = deviceConfig["invert"].toInt(0);
+			_led_string.channel[_channel].strip_type = (deviceConfig["rgbw"].toBool(false) ? SK6812_STRIP_GRBW : WS2811_STRIP_RGB);
+			_led_string.channel[_channel].brightness = 255;
+
+			_led_string.channel[!_channel].gpionum = 0;
+			_led_string.channel[!_channel].invert = _led_string.channel[_channel].invert;
+			_led_string.channel[!_channel].count = 0;
+			_led_string.channel[!_channel].brightness = 0;
+			_led_string.channel[!_channel].strip_type = WS2811_STRIP_RGB;
+
+			Debug( _log, "ws281x strip type : %d", _led_string.channel[_channel].strip_type );
+
+			isInitOK = true;
 		}
 	}
 
-	if ( !isInitOK)
+	if ( !isInitOK && !errortext.isEmpty() )
 	{
 		this->setInError(errortext);
 	}
@@ -122,6 +111,7 @@ int LedDeviceWS281x::close()
 // Send new values down the LED chain
 int LedDeviceWS281x::write(const std::vector<ColorRgb> &ledValues)
 {
+	const bool isRgbw = (_led_string.channel[_channel].strip_type == SK6812_STRIP_GRBW);
 	int idx = 0;
 	for (const ColorRgb& color : ledValues)
 	{
@@ -130,18 +120,10 @@ int LedDeviceWS281x::write(const std::vector<ColorRgb> &ledValues)
 			break;
 		}
 
-		_temp_rgbw.red = color.red;
-		_temp_rgbw.green = color.green;
-		_temp_rgbw.blue = color.blue;
-		_temp_rgbw.white = 0;
-
-		if (_led_string.channel[_channel].strip_type == SK6812_STRIP_GRBW)
-		{
-			Rgb_to_Rgbw(color, &_temp_rgbw, _whiteAlgorithm);
-		}
+		const ColorRgbw rgbw = isRgbw ? _rgbwConverter.convert(color) : ColorRgbw{ color.red, color.green, color.blue, 0 };
 
 		_led_string.channel[_channel].leds[idx++] =
-			((uint32_t)_temp_rgbw.white << 24) + ((uint32_t)_temp_rgbw.red << 16) + ((uint32_t)_temp_rgbw.green << 8) + _temp_rgbw.blue;
+			((uint32_t)rgbw.white << 24) + ((uint32_t)rgbw.red << 16) + ((uint32_t)rgbw.green << 8) + rgbw.blue;
 
 	}
 	while (idx < _led_string.channel[_channel].count)
@@ -74,8 +74,6 @@ private:
 
 	ws2811_t    _led_string;
 	int         _channel;
-	RGBW::WhiteAlgorithm _whiteAlgorithm;
-	ColorRgbw   _temp_rgbw;
 };
 
 #endif // LEDEVICEWS281X_H
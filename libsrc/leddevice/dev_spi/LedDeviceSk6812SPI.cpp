@@ -2,7 +2,6 @@
 
 LedDeviceSk6812SPI::LedDeviceSk6812SPI(const QJsonObject &deviceConfig)
 	: ProviderSpi(deviceConfig)
-	  , _whiteAlgorithm(RGBW::WhiteAlgorithm::INVALID)
 	  , SPI_BYTES_PER_COLOUR(4)
 	  , bitpair_to_byte {
 		  0b10001000,
@@ -27,19 +26,8 @@ bool LedDeviceSk6812SPI::init(const QJsonObject &deviceConfig)
 	// Initialise sub-class
 	if ( ProviderSpi::init(deviceConfig) )
 	{
-		QString whiteAlgorithm = deviceConfig["whiteAlgorithm"].toString("white_off");
-
-		_whiteAlgorithm	= RGBW::stringToWhiteAlgorithm(whiteAlgorithm);
-		if (_whiteAlgorithm == RGBW::WhiteAlgorithm::INVALID)
-		{
-			QString errortext = QString ("unknown whiteAlgorithm: %1").arg(whiteAlgorithm);
-			this->setInError(errortext);
-			isInitOK = false;
-		}
-		else
+		if ( initWhiteAlgorithm(deviceConfig) )
 		{
-			Debug( _log, "whiteAlgorithm : %s", QSTRING_CSTR(whiteAlgorithm));
-
 			WarningIf(( _baudRate_Hz < 2050000 || _baudRate_Hz > 4000000 ), _log, "SPI rate %d outside recommended range (2050000 -> 4000000)", _baudRate_Hz);
 
 			const int SPI_FRAME_END_LATCH_BYTES = 3;
@@ -59,12 +47,12 @@ int LedDeviceSk6812SPI::write(const std::vector<ColorRgb> &ledValues)
 
 	for (const ColorRgb& color : ledValues)
 	{
-		RGBW::Rgb_to_Rgbw(color, &_temp_rgbw, _whiteAlgorithm);
+		const ColorRgbw rgbw = _rgbwConverter.convert(color);
 		uint32_t colorBits = 
-			((uint32_t)_temp_rgbw.red << 24) +
-			((uint32_t)_temp_rgbw.green << 16) +
-			((uint32_t)_temp_rgbw.blue << 8) +
-			_temp_rgbw.white;
+			((uint32_t)rgbw.red << 24) +
+			((uint32_t)rgbw.green << 16) +
+			((uint32_t)rgbw.blue << 8) +
+			rgbw.white;
 
 		for (int j=SPI_BYTES_PER_LED - 1; j>=0; j--)
 		{
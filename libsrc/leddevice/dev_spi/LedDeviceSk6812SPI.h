@@ -43,12 +43,8 @@ private:
 	///
 	int write(const std::vector<ColorRgb> & ledValues) override;
 
-	RGBW::WhiteAlgorithm _whiteAlgorithm;
-
 	const int SPI_BYTES_PER_COLOUR;
 	uint8_t bitpair_to_byte[4];
-
-	ColorRgbw _temp_rgbw;
 };
 
 #endif // LEDEVICESK6812SPI_H
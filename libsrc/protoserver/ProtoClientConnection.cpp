@@ -31,39 +31,30 @@ ProtoClientConnection::ProtoClientConnection(QTcpSocket* socket, int timeout, QO
 
 void ProtoClientConnection::readyRead()
 {
-	_receiveBuffer += _socket->readAll();
+	_receiveBuffer.readFrom(_socket);
 
-	// check if we can read a message size
-	if (_receiveBuffer.size() <= 4)
+	// messages are parsed in place
+	const uint8_t* messageData;
+	uint32_t messageSize;
+	ReceiveBuffer::Result result;
+	while ((result = _receiveBuffer.nextMessage(messageData, messageSize)) == ReceiveBuffer::Result::Message)
 	{
-		return;
-	}
-
-	// read the message size
-	uint32_t messageSize =
-			((_receiveBuffer[0]<<24) & 0xFF000000) |
-			((_receiveBuffer[1]<<16) & 0x00FF0000) |
-			((_receiveBuffer[2]<< 8) & 0x0000FF00) |
-			((_receiveBuffer[3]    ) & 0x000000FF);
+		if (!_request.ParseFromArray(messageData, static_cast<int>(messageSize)))
+		{
+			sendErrorReply("Unable to parse message");
+			continue;
+		}
 
-	// check if we can read a complete message
-	if ((uint32_t) _receiveBuffer.size() < messageSize + 4)
-	{
-		return;
+		// handle the message
+		handleMessage(_request);
 	}
 
-	// read a message
-	proto::HyperionRequest message;
-	if (!message.ParseFromArray(_receiveBuffer.data() + 4, messageSize))
+	if (result == ReceiveBuffer::Result::Invalid)
 	{
-		sendErrorReply("Unable to parse message");
+		Error(_log, "Invalid message size received from client %s", QSTRING_CSTR(_clientAddress));
+		_receiveBuffer.clear();
+		forceClose();
 	}
-
-	// handle the message
-	handleMessage(message);
-
-	// remove message data from buffer
-	_receiveBuffer = _receiveBuffer.mid(messageSize + 4);
 }
 
 void ProtoClientConnection::forceClose()
@@ -182,18 +173,20 @@ void ProtoClientConnection::handleImageCommand(const proto::ImageRequest &messag
 		return;
 	}
 
-	// create ImageRgb
-	Image<ColorRgb> imageRGB(width, height);
+	// decode into a pooled image, no allocation once receivers released the previous frames
+	Image<ColorRgb>& imageRGB = _imagePool.acquire(width, height);
 	if (channelCount == 3)
 	{
-		memmove(imageRGB.memptr(), imageData.c_str(), imageData.size());
+		memcpy(imageRGB.memptr(), imageData.data(), static_cast<size_t>(width) * height * sizeof(ColorRgb));
 	}
 
 	if (channelCount == 4)
 	{
-		for (int source=0, destination=0; source < width * height * static_cast<int>(sizeof(ColorRgb)); source+=sizeof(ColorRgb), destination+=sizeof(ColorRgba))
+		const uint8_t* source = reinterpret_cast<const uint8_t*>(imageData.data());
+		ColorRgb* destination = imageRGB.memptr();
+		for (int pixel = 0; pixel < width * height; ++pixel, source += sizeof(ColorRgba))
 		{
-			memmove((uint8_t*)imageRGB.memptr() + source, imageData.c_str() + destination, sizeof(ColorRgb));
+			destination[pixel] = ColorRgb{ source[0], source[1], source[2] };
 		}
 	}
 
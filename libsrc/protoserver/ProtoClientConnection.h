@@ -11,6 +11,8 @@
 #include <utils/ColorRgb.h>
 #include <utils/ColorRgba.h>
 #include <utils/Components.h>
+#include <utils/ImagePool.h>
+#include <utils/ReceiveBuffer.h>
 
 class QTcpSocket;
 class QTimer;
@@ -155,5 +157,11 @@ private:
 	int _priority;
 
 	/// The buffer used for reading data from the socket
-	QByteArray _receiveBuffer;
+	ReceiveBuffer _receiveBuffer;
+
+	/// The parsed request, reused to keep the allocated fields
+	proto::HyperionRequest _request;
+
+	/// Images the received frames are decoded to
+	ImagePool<ColorRgb> _imagePool;
 };
@@ -88,15 +88,18 @@ void print_trace()
 	if (!size)
 		return;
 
-	Logger* log = Logger::getInstance("CORE");
+	// the messages queued before the crash come first, the writer thread might be stuck or be the crashed one
+	Logger::flushSignalSafe();
+
 	char ** symbols = backtrace_symbols(addresses, size);
 
 	/* Skip first 2 frames as they are signal
-	 * handler and print_trace functions. */
+	 * handler and print_trace functions.
+	 * The trace is written directly, logging could wait for the writer thread. */
 	for (int i = 2; i < size; ++i)
 	{
-		std::string line = "\t" + decipher_trace(symbols[i]);
-		Error(log, line.c_str());
+		std::string line = "\t" + decipher_trace(symbols[i]) + "\n";
+		write_to_stderr(line.c_str(), line.size());
 	}
 
 	free(symbols);
@@ -2,6 +2,89 @@
 #include <utils/ColorSys.h>
 #include <utils/Logger.h>
 
+namespace {
+
+///
+/// Converters of packed RGB pixel formats, used to resample row by row without a per pixel format switch
+///
+struct Bgr16
+{
+	static const int BYTES = 2;
+	static inline void convert(const uint8_t* pixel, ColorRgb& rgb)
+	{
+		// RGB565, little endian
+		const unsigned value = pixel[0] | (pixel[1] << 8);
+		rgb.red   = static_cast<uint8_t>((value >> 8) & 0xF8);
+		rgb.green = static_cast<uint8_t>((value >> 3) & 0xFC);
+		rgb.blue  = static_cast<uint8_t>(value << 3);
+	}
+};
+
+struct Bgr24
+{
+	static const int BYTES = 3;
+	static inline void convert(const uint8_t* pixel, ColorRgb& rgb)
+	{
+		rgb.blue  = pixel[0];
+		rgb.green = pixel[1];
+		rgb.red   = pixel[2];
+	}
+};
+
+struct Rgb32
+{
+	static const int BYTES = 4;
+	static inline void convert(const uint8_t* pixel, ColorRgb& rgb)
+	{
+		rgb.red   = pixel[0];
+		rgb.green = pixel[1];
+		rgb.blue  = pixel[2];
+	}
+};
+
+struct Bgr32
+{
+	static const int BYTES = 4;
+	static inline void convert(const uint8_t* pixel, ColorRgb& rgb)
+	{
+		rgb.blue  = pixel[0];
+		rgb.green = pixel[1];
+		rgb.red   = pixel[2];
+	}
+};
+
+template <typename Format>
+void resamplePacked(const uint8_t * data, int lineLength, int xStart, int yStart, int xStep, int yStep, bool flipX, bool flipY, Image<ColorRgb> & outputImage)
+{
+	const int outputWidth = static_cast<int>(outputImage.width());
+	const int outputHeight = static_cast<int>(outputImage.height());
+	const int sourceStep = xStep * Format::BYTES;
+	ColorRgb* output = outputImage.memptr();
+
+	for (int yDest = 0, ySource = yStart; yDest < outputHeight; ySource += yStep, ++yDest)
+	{
+		const uint8_t* source = data + lineLength * ySource + xStart * Format::BYTES;
+		ColorRgb* dest = output + outputWidth * (flipY ? outputHeight - yDest - 1 : yDest);
+
+		if (flipX)
+		{
+			for (int xDest = outputWidth - 1; xDest >= 0; --xDest, source += sourceStep)
+			{
+				Format::convert(source, dest[xDest]);
+			}
+		}
+		else
+		{
+			for (int xDest = 0; xDest < outputWidth; ++xDest, source += sourceStep)
+			{
+				Format::convert(source, dest[xDest]);
+			}
+		}
+	}
+}
+
+} // namespace
+
 ImageResampler::ImageResampler()
 	: _horizontalDecimation(8)
 	, _verticalDecimation(8)
@@ -48,6 +131,30 @@ void ImageResampler::processImage(const uint8_t * data, int width, int height, i
 
 	outputImage.resize(outputWidth, outputHeight);
 
+	// packed RGB formats are resampled row by row, flipping as in the generic loop below
+	// (a horizontal flip mirrors the rows, a vertical flip the columns)
+	const int xStart = _cropLeft + (_horizontalDecimation >> 1);
+	const int yStart = _cropTop + (_verticalDecimation >> 1);
+	const bool flipX = (_flipMode == FlipMode::VERTICAL || _flipMode == FlipMode::BOTH);
+	const bool flipY = (_flipMode == FlipMode::HORIZONTAL || _flipMode == FlipMode::BOTH);
+	switch (pixelFormat)
+	{
+	case PixelFormat::BGR16:
+		resamplePacked<Bgr16>(data, lineLength, xStart, yStart, _horizontalDecimation, _verticalDecimation, flipX, flipY, outputImage);
+		return;
+	case PixelFormat::BGR24:
+		resamplePacked<Bgr24>(data, lineLength, xStart, yStart, _horizontalDecimation, _verticalDecimation, flipX, flipY, outputImage);
+		return;
+	case PixelFormat::RGB32:
+		resamplePacked<Rgb32>(data, lineLength, xStart, yStart, _horizontalDecimation, _verticalDecimation, flipX, flipY, outputImage);
+		return;
+	case PixelFormat::BGR32:
+		resamplePacked<Bgr32>(data, lineLength, xStart, yStart, _horizontalDecimation, _verticalDecimation, flipX, flipY, outputImage);
+		return;
+	default:
+		break;
+	}
+
 	for (int yDest = 0, ySource = _cropTop + (_verticalDecimation >> 1); yDest < outputHeight; ySource += _verticalDecimation, ++yDest)
 	{
 		int yOffset = lineLength * ySource;
@@ -1,12 +1,20 @@
 #include <utils/Logger.h>
 #include <utils/FileUtils.h>
 
-#include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #ifndef _WIN32
 #include <syslog.h>
+#include <unistd.h>
 #elif _WIN32
+#include <io.h>
 #include <windows.h>
 #include <Shlwapi.h>
 #pragma comment(lib, "Shlwapi.lib")
@@ -14,7 +22,6 @@
 #include <QDateTime>
 #include <QFileInfo>
 #include <QMutexLocker>
-#include <QThreadStorage>
 #include <time.h>
 
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 14, 0))
@@ -34,13 +41,452 @@ const int    LogLevelSysLog[]    = { LOG_DEBUG, LOG_DEBUG, LOG_INFO, LOG_WARNING
 #endif
 
 const size_t MAX_IDENTIFICATION_LENGTH = 22;
+const size_t MAX_MSG_LENGTH = 1024;
 
 QAtomicInteger<unsigned int> LoggerCount = 0;
 QAtomicInteger<unsigned int> LoggerId    = 0;
 
 const int MaxRepeatCountSize = 200;
-QThreadStorage<int> RepeatCount;
-QThreadStorage<Logger::T_LOG_MESSAGE> RepeatMessage;
+
+/// Records per thread queue, a power of two
+const unsigned QUEUE_CAPACITY = 128;
+
+/// Interval the writer looks for messages without being woken up
+const std::chrono::milliseconds WRITER_INTERVAL(100);
+
+/// Queues which can be drained by a signal handler, further threads are not covered
+const int MAX_SIGNAL_QUEUES = 64;
+
+class LogQueue;
+
+/// Registry of the queues without a lock, read by Logger::flushSignalSafe()
+std::atomic<LogQueue*> signalQueues[MAX_SIGNAL_QUEUES];
+
+/// Set by a signal handler draining the queues, the writer stops consuming and releasing them
+std::atomic<bool> signalDraining(false);
+
+/// Set when the writer is destroyed during the static teardown, messages are written directly afterwards
+std::atomic<bool> writerDestroyed(false);
+
+/// Write to stdout, usable in a signal handler
+void writeRaw(const char* data, size_t size)
+{
+	// bounded, a blocked or broken stdout must not stall the handler
+	for (int retry = 0; size > 0 && retry < 16; ++retry)
+	{
+#ifndef _WIN32
+		const ssize_t written = ::write(STDOUT_FILENO, data, size);
+#else
+		const int written = _write(1, data, static_cast<unsigned int>(size));
+#endif
+		if (written > 0)
+		{
+			data += written;
+			size -= static_cast<size_t>(written);
+		}
+	}
+}
+
+/// Append a string to a fixed buffer, non ASCII characters are replaced, usable in a signal handler
+size_t appendRaw(char* buffer, size_t pos, size_t capacity, const char* text)
+{
+	for (; *text != '\0' && pos < capacity; ++text)
+	{
+		buffer[pos++] = *text;
+	}
+	return pos;
+}
+
+size_t appendRaw(char* buffer, size_t pos, size_t capacity, const QString& text)
+{
+	const QChar* data = text.constData();
+	for (int i = 0; i < text.size() && pos < capacity; ++i)
+	{
+		const ushort c = data[i].unicode();
+		buffer[pos++] = (c < 0x80) ? static_cast<char>(c) : '?';
+	}
+	return pos;
+}
+
+///
+/// A message as queued by the logging thread. File and function are string literals of the call site.
+///
+struct LogRecord
+{
+	QString          loggerName;
+	QString          loggerSubName;
+	const char*      function;
+	const char*      sourceFile;
+	unsigned int     line;
+	qint64           utime;
+	Logger::LogLevel level;
+	char             message[MAX_MSG_LENGTH];
+};
+
+///
+/// Single producer, single consumer ring of records. The logging thread formats into a free record and publishes it,
+/// the writer thread consumes it. Neither side takes a lock.
+///
+class LogQueue
+{
+public:
+	LogQueue()
+		: _records(new LogRecord[QUEUE_CAPACITY])
+		, _head(0)
+		, _tail(0)
+		, _dropped(0)
+		, _closed(false)
+		, repeatCount(0)
+	{
+	}
+
+	~LogQueue()
+	{
+		delete[] _records;
+	}
+
+	/// Producer: a free record or nullptr, if the queue is full
+	LogRecord* reserve()
+	{
+		const unsigned head = _head.load(std::memory_order_relaxed);
+		if (head - _tail.load(std::memory_order_acquire) >= QUEUE_CAPACITY)
+		{
+			return nullptr;
+		}
+		return &_records[head % QUEUE_CAPACITY];
+	}
+
+	/// Producer: publish the reserved record
+	void publish()
+	{
+		_head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	/// Producer: count a message dropped on a full queue
+	void drop()
+	{
+		_dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	/// Producer: the thread finished, the writer releases the queue once it is empty
+	void close()
+	{
+		_closed.store(true, std::memory_order_release);
+	}
+
+	/// Consumer: the oldest record or nullptr, if the queue is empty
+	LogRecord* front()
+	{
+		const unsigned tail = _tail.load(std::memory_order_relaxed);
+		if (tail == _head.load(std::memory_order_acquire))
+		{
+			return nullptr;
+		}
+		return &_records[tail % QUEUE_CAPACITY];
+	}
+
+	/// Consumer: release the oldest record
+	void pop()
+	{
+		_tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	/// Consumer: messages dropped since the last call
+	quint64 takeDropped()
+	{
+		const quint64 dropped = _dropped.load(std::memory_order_relaxed);
+		const quint64 result = dropped - _reportedDropped;
+		_reportedDropped = dropped;
+		return result;
+	}
+
+	bool isClosed() const
+	{
+		return _closed.load(std::memory_order_acquire);
+	}
+
+	bool isEmpty() const
+	{
+		return _tail.load(std::memory_order_relaxed) == _head.load(std::memory_order_acquire);
+	}
+
+private:
+	LogRecord*            _records;
+	std::atomic<unsigned> _head;
+	std::atomic<unsigned> _tail;
+	std::atomic<quint64>  _dropped;
+	quint64               _reportedDropped = 0;
+	std::atomic<bool>     _closed;
+
+public:
+	// repeated message detection of the producing thread, used by the writer only
+	Logger::T_LOG_MESSAGE repeatMessage;
+	QByteArray            repeatText;
+	int                   repeatCount;
+};
+
+///
+/// The writer thread. It collects the records of all threads, formats them and writes them in batches.
+///
+class LogWriter
+{
+public:
+	static LogWriter& getInstance()
+	{
+		static LogWriter instance;
+		return instance;
+	}
+
+	/// The queue of the calling thread, registered on first use
+	LogQueue& localQueue()
+	{
+		struct Holder
+		{
+			std::shared_ptr<LogQueue> queue;
+
+			Holder()
+				: queue(std::make_shared<LogQueue>())
+			{
+				LogWriter& writer = LogWriter::getInstance();
+				std::lock_guard<std::mutex> lock(writer._mutex);
+				writer._queues.push_back(queue);
+
+				for (auto& slot : signalQueues)
+				{
+					LogQueue* expected = nullptr;
+					if (slot.compare_exchange_strong(expected, queue.get()))
+					{
+						break;
+					}
+				}
+			}
+
+			~Holder()
+			{
+				queue->close();
+			}
+		};
+
+		thread_local Holder holder;
+		return *holder.queue;
+	}
+
+	/// Wake up the writer, if it waits for messages. A missed wake up only delays the messages by the writer interval.
+	void wakeUp()
+	{
+		if (_sleeping.load(std::memory_order_acquire))
+		{
+			_wakeUp.notify_one();
+		}
+	}
+
+	/// Wait until the writer emptied all queues
+	void flush()
+	{
+		for (int retry = 0; retry < 1000; ++retry)
+		{
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				if (_idle && std::all_of(_queues.begin(), _queues.end(), [](const std::shared_ptr<LogQueue>& queue) { return queue->isEmpty(); }))
+				{
+					return;
+				}
+			}
+			_wakeUp.notify_one();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+private:
+	LogWriter()
+		: _running(true)
+		, _sleeping(false)
+		, _idle(true)
+	{
+		// the manager has to outlive the writer
+		LoggerManager::getInstance();
+		_thread = std::thread(&LogWriter::run, this);
+	}
+
+	~LogWriter()
+	{
+		writerDestroyed.store(true);
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_running = false;
+		}
+		_wakeUp.notify_one();
+		_thread.join();
+	}
+
+	void run()
+	{
+		QByteArray batch;
+		for (;;)
+		{
+			std::vector<std::shared_ptr<LogQueue>> queues;
+			bool running;
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				// release the queues of finished threads after their last records were written
+				_queues.erase(std::remove_if(_queues.begin(), _queues.end(), [](const std::shared_ptr<LogQueue>& queue) {
+					if (!queue->isClosed() || !queue->isEmpty() || queue->repeatCount != 0)
+					{
+						return false;
+					}
+					for (auto& slot : signalQueues)
+					{
+						LogQueue* expected = queue.get();
+						slot.compare_exchange_strong(expected, nullptr);
+					}
+					// a signal handler, which might have read the slot before, keeps the queue alive
+					return !signalDraining.load();
+				}), _queues.end());
+				queues = _queues;
+				running = _running;
+				_idle = false;
+			}
+
+			for (const auto& queue : queues)
+			{
+				drain(*queue, batch, running);
+			}
+
+			if (!batch.isEmpty())
+			{
+				fwrite(batch.constData(), 1, static_cast<size_t>(batch.size()), stdout);
+				fflush(stdout);
+				batch.clear();
+			}
+
+			std::unique_lock<std::mutex> lock(_mutex);
+			_idle = true;
+			if (!running)
+			{
+				break;
+			}
+			_sleeping.store(true, std::memory_order_release);
+			_wakeUp.wait_for(lock, WRITER_INTERVAL);
+			_sleeping.store(false, std::memory_order_relaxed);
+		}
+	}
+
+	void drain(LogQueue& queue, QByteArray& batch, bool running)
+	{
+		const quint64 dropped = queue.takeDropped();
+		if (dropped > 0)
+		{
+			Logger::T_LOG_MESSAGE dropMsg = queue.repeatMessage;
+			dropMsg.message = QString::number(dropped) + " messages dropped, the log could not keep up";
+			dropMsg.level = Logger::WARNING;
+			dropMsg.levelString = LogLevelStrings[Logger::WARNING];
+			dropMsg.utime = QDateTime::currentMSecsSinceEpoch();
+			write(dropMsg, batch, running);
+		}
+
+		while (const LogRecord* record = queue.front())
+		{
+			// the records belong to the signal handler now
+			if (signalDraining.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			Logger::T_LOG_MESSAGE& repeatMsg = queue.repeatMessage;
+			if (repeatMsg.loggerName == record->loggerName &&
+				repeatMsg.loggerSubName == record->loggerSubName &&
+				repeatMsg.function == QLatin1String(record->function) &&
+				queue.repeatText == record->message &&
+				repeatMsg.line == record->line)
+			{
+				if (queue.repeatCount >= MaxRepeatCountSize)
+					writeRepeated(queue, batch, running);
+				else
+					++queue.repeatCount;
+			}
+			else
+			{
+				if (queue.repeatCount)
+					writeRepeated(queue, batch, running);
+
+				repeatMsg.loggerName    = record->loggerName;
+				repeatMsg.loggerSubName = record->loggerSubName;
+				repeatMsg.function      = QString(record->function);
+				repeatMsg.line          = record->line;
+				repeatMsg.fileName      = FileUtils::getBaseName(record->sourceFile);
+				repeatMsg.utime         = static_cast<uint64_t>(record->utime);
+				repeatMsg.message       = QString(record->message);
+				queue.repeatText        = record->message;
+				repeatMsg.level         = record->level;
+				repeatMsg.levelString   = LogLevelStrings[record->level];
+
+				write(repeatMsg, batch, running);
+#ifndef _WIN32
+				if ( record->level >= Logger::WARNING )
+					syslog (LogLevelSysLog[record->level], "%s", record->message);
+#endif
+			}
+			queue.pop();
+		}
+
+		// the thread finished, summarize its last repeated line
+		if (queue.isClosed() && queue.repeatCount)
+			writeRepeated(queue, batch, running);
+	}
+
+	void writeRepeated(LogQueue& queue, QByteArray& batch, bool running)
+	{
+		Logger::T_LOG_MESSAGE repMsg = queue.repeatMessage;
+		repMsg.message = "Previous line repeats " + QString::number(queue.repeatCount) + " times";
+		repMsg.utime   = QDateTime::currentMSecsSinceEpoch();
+
+		write(repMsg, batch, running);
+#ifndef _WIN32
+		if ( repMsg.level >= Logger::WARNING )
+			syslog (LogLevelSysLog[repMsg.level], "Previous line repeats %d times", queue.repeatCount);
+#endif
+
+		queue.repeatCount = 0;
+	}
+
+	void write(const Logger::T_LOG_MESSAGE & message, QByteArray& batch, bool running)
+	{
+		QString name = "|" + message.loggerSubName + "| " + message.loggerName;
+		name.resize(MAX_IDENTIFICATION_LENGTH, ' ');
+
+		batch += QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(message.utime)).toString("yyyy-MM-ddThh:mm:ss.zzz").toUtf8();
+		batch += ' ';
+		batch += name.toUtf8();
+		batch += " : <";
+		batch += LogLevelStrings[message.level];
+		batch += "> ";
+		if (message.level == Logger::DEBUG)
+		{
+			batch += message.fileName.toUtf8();
+			batch += ':';
+			batch += QByteArray::number(message.line);
+			batch += ':';
+			batch += message.function.toUtf8();
+			batch += "() | ";
+		}
+		batch += message.message.toUtf8();
+		batch += '\n';
+
+		// the manager is not served any more while the process exits
+		if (running)
+		{
+			QMetaObject::invokeMethod(LoggerManager::getInstance(), "handleNewLogMessage", Qt::QueuedConnection, Q_ARG(Logger::T_LOG_MESSAGE, message));
+		}
+	}
+
+	std::mutex                             _mutex;
+	std::condition_variable                _wakeUp;
+	std::vector<std::shared_ptr<LogQueue>> _queues;
+	bool                                   _running;
+	std::atomic<bool>                      _sleeping;
+	bool                                   _idle;
+	std::thread                            _thread;
+};
 } // namespace
 
 Logger* Logger::getInstance(const QString & name, const QString & subName, Logger::LogLevel minLevel)
@@ -53,7 +499,8 @@ Logger* Logger::getInstance(const QString & name, const QString & subName, Logge
 		log = new Logger(name, subName, minLevel);
 		LoggerMap.insert(name, log); // compat version, replace it with following line if we have 100% c++11
 		//LoggerMap.emplace(name, log);  // not compat with older linux distro's e.g. wheezy
-		connect(log, &Logger::newLogMessage, LoggerManager::getInstance(), &LoggerManager::handleNewLogMessage);
+		// the manager lives in the thread of the first logger, messages are forwarded to it by the writer
+		LoggerManager::getInstance();
 	}
 
 	return log;
@@ -139,99 +586,117 @@ Logger::~Logger()
 	}
 }
 
-void Logger::write(const Logger::T_LOG_MESSAGE & message)
+void Logger::flush()
 {
-	QString location;
-	if (message.level == Logger::DEBUG)
+	if (!writerDestroyed.load())
 	{
-		location = QString("%1:%2:%3() | ")
-			.arg(message.fileName)
-			.arg(message.line)
-			.arg(message.function);
+		LogWriter::getInstance().flush();
 	}
+}
 
-	QString name = "|" + message.loggerSubName + "| " + message.loggerName;
-	name.resize(MAX_IDENTIFICATION_LENGTH, ' ');
+void Logger::flushSignalSafe()
+{
+	// only the first handler drains, a recursive or concurrent signal does not wait for it
+	if (signalDraining.exchange(true))
+	{
+		return;
+	}
 
-	const QDateTime timestamp = QDateTime::fromMSecsSinceEpoch(message.utime);
+	char line[MAX_IDENTIFICATION_LENGTH + MAX_MSG_LENGTH + 32];
+	const size_t capacity = sizeof(line) - 1;
 
-	std::cout << QString("%1 %2 : <%3> %4%5")
-			.arg(timestamp.toString("yyyy-MM-ddThh:mm:ss.zzz"))
-			.arg(name)
-			.arg(LogLevelStrings[message.level])
-			.arg(location)
-			.arg(message.message)
-		.toStdString()
-	<< std::endl;
+	for (auto& slot : signalQueues)
+	{
+		LogQueue* queue = slot.load();
+		if (queue == nullptr)
+		{
+			continue;
+		}
 
-	newLogMessage(message);
+		for (unsigned count = 0; count < QUEUE_CAPACITY; ++count)
+		{
+			const LogRecord* record = queue->front();
+			if (record == nullptr)
+			{
+				break;
+			}
+
+			size_t pos = appendRaw(line, 0, capacity, "|");
+			pos = appendRaw(line, pos, capacity, record->loggerSubName);
+			pos = appendRaw(line, pos, capacity, "| ");
+			pos = appendRaw(line, pos, capacity, record->loggerName);
+			pos = appendRaw(line, pos, capacity, " : <");
+			pos = appendRaw(line, pos, capacity, LogLevelStrings[record->level]);
+			pos = appendRaw(line, pos, capacity, "> ");
+			pos = appendRaw(line, pos, capacity, record->message);
+			line[pos++] = '\n';
+			writeRaw(line, pos);
+
+			queue->pop();
+		}
+	}
 }
 
 void Logger::Message(LogLevel level, const char* sourceFile, const char* func, unsigned int line, const char* fmt, ...)
 {
-	Logger::LogLevel globalLevel = static_cast<Logger::LogLevel>(int(GLOBAL_MIN_LOG_LEVEL));
-
-	if ( (globalLevel == Logger::UNSET && level < _minLevel) // no global level, use level from logger
-	  || (globalLevel > Logger::UNSET && level < globalLevel) ) // global level set, use global level
+	if (!isEnabled(level))
 		return;
 
-	const size_t max_msg_length = 1024;
-	char msg[max_msg_length];
-	va_list args;
-	va_start (args, fmt);
-	vsnprintf (msg, max_msg_length, fmt, args);
-	va_end (args);
-
-	const auto repeatedSummary = [&]
+	// messages of static destructors running after the writer was destroyed
+	if (writerDestroyed.load(std::memory_order_relaxed))
 	{
-		Logger::T_LOG_MESSAGE repMsg = RepeatMessage.localData();
-		repMsg.message = "Previous line repeats " + QString::number(RepeatCount.localData()) + " times";
-		repMsg.utime   = QDateTime::currentMSecsSinceEpoch();
-
-		write(repMsg);
-#ifndef _WIN32
-		if ( _syslogEnabled && repMsg.level >= Logger::WARNING )
-			syslog (LogLevelSysLog[repMsg.level], "Previous line repeats %d times", RepeatCount.localData());
-#endif
+		char message[MAX_MSG_LENGTH];
+		va_list args;
+		va_start (args, fmt);
+		vsnprintf (message, MAX_MSG_LENGTH, fmt, args);
+		va_end (args);
+
+		fprintf(stdout, "|%s| %s : <%s> %s\n", QSTRING_CSTR(_subname), QSTRING_CSTR(_name), LogLevelStrings[level], message);
+		fflush(stdout);
+		return;
+	}
 
-		RepeatCount.setLocalData(0);
-	};
+	LogWriter& writer = LogWriter::getInstance();
+	LogQueue& queue = writer.localQueue();
 
-	if (RepeatMessage.localData().loggerName == _name  &&
-		RepeatMessage.localData().loggerSubName == _subname  &&
-		RepeatMessage.localData().function == func &&
-		RepeatMessage.localData().message == msg   &&
-		RepeatMessage.localData().line == line)
+	LogRecord* record = queue.reserve();
+	if (record == nullptr)
 	{
-		if (RepeatCount.localData() >= MaxRepeatCountSize)
-			repeatedSummary();
-		else
-			RepeatCount.setLocalData(RepeatCount.localData() + 1);
+		// debug and info messages are dropped, if the writer does not keep up, warnings and errors wait for it.
+		// Nobody consumes the queue any more after a crash, so messages are dropped then as well
+		if (level < Logger::WARNING || signalDraining.load(std::memory_order_relaxed))
+		{
+			queue.drop();
+			return;
+		}
+
+		while ((record = queue.reserve()) == nullptr)
+		{
+			if (signalDraining.load(std::memory_order_relaxed))
+			{
+				queue.drop();
+				return;
+			}
+			writer.wakeUp();
+			std::this_thread::yield();
+		}
 	}
-	else
-	{
-		if (RepeatCount.localData())
-			repeatedSummary();
 
-		Logger::T_LOG_MESSAGE logMsg;
+	va_list args;
+	va_start (args, fmt);
+	vsnprintf (record->message, MAX_MSG_LENGTH, fmt, args);
+	va_end (args);
 
-		logMsg.loggerName  = _name;
-		logMsg.loggerSubName  = _subname;
-		logMsg.function    = QString(func);
-		logMsg.line        = line;
-		logMsg.fileName    = FileUtils::getBaseName(sourceFile);
-		logMsg.utime       = QDateTime::currentMSecsSinceEpoch();
-		logMsg.message     = QString(msg);
-		logMsg.level       = level;
-		logMsg.levelString = LogLevelStrings[level];
+	record->loggerName    = _name;
+	record->loggerSubName = _subname;
+	record->function      = func;
+	record->sourceFile    = sourceFile;
+	record->line          = line;
+	record->utime         = QDateTime::currentMSecsSinceEpoch();
+	record->level         = level;
 
-		write(logMsg);
-#ifndef _WIN32
-		if ( _syslogEnabled && level >= Logger::WARNING )
-			syslog (LogLevelSysLog[level], "%s", msg);
-#endif
-		RepeatMessage.setLocalData(logMsg);
-	}
+	queue.publish();
+	writer.wakeUp();
 }
 
 LoggerManager::LoggerManager()
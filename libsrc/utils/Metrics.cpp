@@ -0,0 +1,369 @@
+// project includes
+#include <utils/Metrics.h>
+
+// qt includes
+#include <QJsonArray>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+
+// stl includes
+#include <atomic>
+#include <cstring>
+
+namespace {
+
+/// Upper bounds of the histogram buckets in microseconds
+const qint64 BUCKET_BOUNDS_US[Metrics::BUCKET_COUNT - 1] = { 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000 };
+
+/// Minimum interval the frame rates are computed over
+const qint64 RATE_INTERVAL_MS = 1000;
+
+const char* const STAGE_NAMES[Metrics::STAGE_COUNT] = { "grab", "decode", "process", "adjust", "smoothing", "write" };
+
+///
+/// The metrics recorded by a single thread
+///
+struct Accumulator
+{
+	std::atomic<quint64> buckets[Metrics::STAGE_COUNT][Metrics::BUCKET_COUNT];
+	std::atomic<quint64> sum[Metrics::STAGE_COUNT];
+	std::atomic<quint64> max[Metrics::STAGE_COUNT];
+	std::atomic<quint64> counters[Metrics::MAX_INSTANCES][Metrics::COUNTER_COUNT];
+
+	Accumulator()
+	{
+		for (int stage = 0; stage < Metrics::STAGE_COUNT; ++stage)
+		{
+			for (auto& bucket : buckets[stage])
+			{
+				bucket.store(0, std::memory_order_relaxed);
+			}
+			sum[stage].store(0, std::memory_order_relaxed);
+			max[stage].store(0, std::memory_order_relaxed);
+		}
+		for (auto& instance : counters)
+		{
+			for (auto& counter : instance)
+			{
+				counter.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+};
+
+///
+/// Sum of all accumulators
+///
+struct Totals
+{
+	quint64 buckets[Metrics::STAGE_COUNT][Metrics::BUCKET_COUNT] = {};
+	quint64 sum[Metrics::STAGE_COUNT] = {};
+	quint64 max[Metrics::STAGE_COUNT] = {};
+	quint64 counters[Metrics::MAX_INSTANCES][Metrics::COUNTER_COUNT] = {};
+
+	void add(const Accumulator& accumulator)
+	{
+		for (int stage = 0; stage < Metrics::STAGE_COUNT; ++stage)
+		{
+			for (int bucket = 0; bucket < Metrics::BUCKET_COUNT; ++bucket)
+			{
+				buckets[stage][bucket] += accumulator.buckets[stage][bucket].load(std::memory_order_relaxed);
+			}
+			sum[stage] += accumulator.sum[stage].load(std::memory_order_relaxed);
+			max[stage] = qMax(max[stage], accumulator.max[stage].load(std::memory_order_relaxed));
+		}
+		for (int instance = 0; instance < Metrics::MAX_INSTANCES; ++instance)
+		{
+			for (int counter = 0; counter < Metrics::COUNTER_COUNT; ++counter)
+			{
+				counters[instance][counter] += accumulator.counters[instance][counter].load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	quint64 count(int stage) const
+	{
+		quint64 result = 0;
+		for (quint64 bucket : buckets[stage])
+		{
+			result += bucket;
+		}
+		return result;
+	}
+
+	/// Estimates a percentile by the upper bound of its bucket
+	double percentileUs(int stage, double percentile) const
+	{
+		const quint64 total = count(stage);
+		quint64 cumulated = 0;
+		for (int bucket = 0; bucket < Metrics::BUCKET_COUNT - 1; ++bucket)
+		{
+			cumulated += buckets[stage][bucket];
+			if (cumulated >= total * percentile)
+			{
+				return qMin(static_cast<double>(BUCKET_BOUNDS_US[bucket]), max[stage] / 1000.0);
+			}
+		}
+		return max[stage] / 1000.0;
+	}
+};
+
+///
+/// All accumulators of running threads and the sum of the finished ones
+///
+struct Registry
+{
+	QMutex mutex;
+	QList<Accumulator*> active;
+	Accumulator finished;
+
+	// frame rates of the instances, computed on request
+	QElapsedTimer rateTimer;
+	quint64 lastCounters[Metrics::MAX_INSTANCES][Metrics::COUNTER_COUNT] = {};
+	double rates[Metrics::MAX_INSTANCES][Metrics::COUNTER_COUNT] = {};
+
+	static Registry& getInstance()
+	{
+		static Registry instance;
+		return instance;
+	}
+
+	Totals totals()
+	{
+		Totals result;
+		result.add(finished);
+		for (const Accumulator* accumulator : active)
+		{
+			result.add(*accumulator);
+		}
+		return result;
+	}
+
+	void updateRates(const Totals& totals)
+	{
+		if (!rateTimer.isValid())
+		{
+			rateTimer.start();
+			memcpy(lastCounters, totals.counters, sizeof(lastCounters));
+			return;
+		}
+
+		const qint64 elapsed = rateTimer.elapsed();
+		if (elapsed < RATE_INTERVAL_MS)
+		{
+			return;
+		}
+		rateTimer.restart();
+
+		for (int instance = 0; instance < Metrics::MAX_INSTANCES; ++instance)
+		{
+			for (int counter = 0; counter < Metrics::COUNTER_COUNT; ++counter)
+			{
+				rates[instance][counter] = (totals.counters[instance][counter] - lastCounters[instance][counter]) * 1000.0 / elapsed;
+			}
+		}
+		memcpy(lastCounters, totals.counters, sizeof(lastCounters));
+	}
+};
+
+///
+/// Registers the accumulator of a thread and merges it into the finished ones on thread exit
+///
+struct ThreadAccumulator
+{
+	Accumulator* accumulator;
+
+	ThreadAccumulator()
+		: accumulator(new Accumulator)
+	{
+		Registry& registry = Registry::getInstance();
+		QMutexLocker lock(&registry.mutex);
+		registry.active.append(accumulator);
+	}
+
+	~ThreadAccumulator()
+	{
+		Registry& registry = Registry::getInstance();
+		QMutexLocker lock(&registry.mutex);
+		registry.active.removeOne(accumulator);
+
+		Accumulator& finished = registry.finished;
+		for (int stage = 0; stage < Metrics::STAGE_COUNT; ++stage)
+		{
+			for (int bucket = 0; bucket < Metrics::BUCKET_COUNT; ++bucket)
+			{
+				finished.buckets[stage][bucket].fetch_add(accumulator->buckets[stage][bucket].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+			finished.sum[stage].fetch_add(accumulator->sum[stage].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			finished.max[stage].store(qMax(finished.max[stage].load(std::memory_order_relaxed), accumulator->max[stage].load(std::memory_order_relaxed)), std::memory_order_relaxed);
+		}
+		for (int instance = 0; instance < Metrics::MAX_INSTANCES; ++instance)
+		{
+			for (int counter = 0; counter < Metrics::COUNTER_COUNT; ++counter)
+			{
+				finished.counters[instance][counter].fetch_add(accumulator->counters[instance][counter].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+		}
+		delete accumulator;
+	}
+};
+
+inline Accumulator& localAccumulator()
+{
+	thread_local ThreadAccumulator local;
+	return *local.accumulator;
+}
+
+/// Only the owning thread writes its accumulator, a plain load and store is sufficient
+inline void increment(std::atomic<quint64>& value, quint64 amount)
+{
+	value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+/// Formats a value for the Prometheus text format
+QByteArray number(double value)
+{
+	return QByteArray::number(value, 'g', 10);
+}
+
+} // namespace
+
+void Metrics::record(Stage stage, qint64 nanoseconds)
+{
+	Accumulator& accumulator = localAccumulator();
+	const quint64 duration = static_cast<quint64>(qMax(nanoseconds, qint64(0)));
+	const qint64 durationUs = nanoseconds / 1000;
+
+	int bucket = 0;
+	while (bucket < BUCKET_COUNT - 1 && durationUs >= BUCKET_BOUNDS_US[bucket])
+	{
+		++bucket;
+	}
+
+	increment(accumulator.buckets[stage][bucket], 1);
+	increment(accumulator.sum[stage], duration);
+	if (duration > accumulator.max[stage].load(std::memory_order_relaxed))
+	{
+		accumulator.max[stage].store(duration, std::memory_order_relaxed);
+	}
+}
+
+void Metrics::count(quint8 instance, Counter counter)
+{
+	increment(localAccumulator().counters[instance][counter], 1);
+}
+
+const char* Metrics::stageName(Stage stage)
+{
+	return (stage >= 0 && stage < STAGE_COUNT) ? STAGE_NAMES[stage] : "unknown";
+}
+
+QJsonObject Metrics::toJson()
+{
+	Registry& registry = Registry::getInstance();
+	QMutexLocker lock(&registry.mutex);
+	const Totals totals = registry.totals();
+	registry.updateRates(totals);
+
+	QJsonArray bounds;
+	for (qint64 bound : BUCKET_BOUNDS_US)
+	{
+		bounds.append(static_cast<double>(bound));
+	}
+
+	QJsonObject stages;
+	for (int stage = 0; stage < STAGE_COUNT; ++stage)
+	{
+		const quint64 count = totals.count(stage);
+
+		QJsonArray buckets;
+		for (quint64 bucket : totals.buckets[stage])
+		{
+			buckets.append(static_cast<double>(bucket));
+		}
+
+		QJsonObject histogram;
+		histogram["count"] = static_cast<double>(count);
+		histogram["avg_us"] = (count > 0) ? totals.sum[stage] / 1000.0 / count : 0.0;
+		histogram["max_us"] = totals.max[stage] / 1000.0;
+		histogram["p50_us"] = totals.percentileUs(stage, 0.50);
+		histogram["p95_us"] = totals.percentileUs(stage, 0.95);
+		histogram["p99_us"] = totals.percentileUs(stage, 0.99);
+		histogram["buckets"] = buckets;
+		stages[STAGE_NAMES[stage]] = histogram;
+	}
+
+	QJsonArray instances;
+	for (int instance = 0; instance < MAX_INSTANCES; ++instance)
+	{
+		const quint64* counters = totals.counters[instance];
+		if (counters[UPDATES] == 0 && counters[WRITES] == 0 && counters[DROPPED] == 0)
+		{
+			continue;
+		}
+
+		QJsonObject entry;
+		entry["instance"] = instance;
+		entry["updates"] = static_cast<double>(counters[UPDATES]);
+		entry["writes"] = static_cast<double>(counters[WRITES]);
+		entry["dropped"] = static_cast<double>(counters[DROPPED]);
+		entry["update_fps"] = registry.rates[instance][UPDATES];
+		entry["write_fps"] = registry.rates[instance][WRITES];
+		entry["dropped_fps"] = registry.rates[instance][DROPPED];
+		instances.append(entry);
+	}
+
+	QJsonObject metrics;
+	metrics["bucket_bounds_us"] = bounds;
+	metrics["stages"] = stages;
+	metrics["instances"] = instances;
+	return metrics;
+}
+
+QByteArray Metrics::toPrometheus()
+{
+	Totals totals;
+	{
+		Registry& registry = Registry::getInstance();
+		QMutexLocker lock(&registry.mutex);
+		totals = registry.totals();
+	}
+
+	QByteArray text;
+	text += "# HELP hyperion_stage_duration_seconds Duration of the processing stages\n";
+	text += "# TYPE hyperion_stage_duration_seconds histogram\n";
+	for (int stage = 0; stage < STAGE_COUNT; ++stage)
+	{
+		const QByteArray label = QByteArray("stage=\"") + STAGE_NAMES[stage] + "\"";
+		quint64 cumulated = 0;
+		for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+		{
+			cumulated += totals.buckets[stage][bucket];
+			const QByteArray bound = (bucket < BUCKET_COUNT - 1) ? number(BUCKET_BOUNDS_US[bucket] / 1e6) : QByteArray("+Inf");
+			text += "hyperion_stage_duration_seconds_bucket{" + label + ",le=\"" + bound + "\"} " + QByteArray::number(cumulated) + "\n";
+		}
+		text += "hyperion_stage_duration_seconds_sum{" + label + "} " + number(totals.sum[stage] / 1e9) + "\n";
+		text += "hyperion_stage_duration_seconds_count{" + label + "} " + QByteArray::number(cumulated) + "\n";
+	}
+
+	const struct { Counter counter; const char* name; const char* help; } counters[] = {
+		{ UPDATES, "hyperion_led_updates_total", "Updates of the LED colors" },
+		{ WRITES, "hyperion_device_writes_total", "Frames written to the LED device" },
+		{ DROPPED, "hyperion_dropped_frames_total", "Frames not written to the LED device within its latch time" } };
+
+	for (const auto& counter : counters)
+	{
+		text += QByteArray("# HELP ") + counter.name + " " + counter.help + "\n";
+		text += QByteArray("# TYPE ") + counter.name + " counter\n";
+		for (int instance = 0; instance < MAX_INSTANCES; ++instance)
+		{
+			const quint64* values = totals.counters[instance];
+			if (values[UPDATES] > 0 || values[WRITES] > 0 || values[DROPPED] > 0)
+			{
+				text += QByteArray(counter.name) + "{instance=\"" + QByteArray::number(instance) + "\"} " + QByteArray::number(values[counter.counter]) + "\n";
+			}
+		}
+	}
+	return text;
+}
@@ -0,0 +1,92 @@
+#include <utils/ReceiveBuffer.h>
+
+// Qt includes
+#include <QIODevice>
+
+#include <cstring>
+
+namespace {
+const int INITIAL_CAPACITY = 64 * 1024;
+const int HEADER_SIZE = 4;
+}
+
+ReceiveBuffer::ReceiveBuffer(uint32_t maxMessageSize)
+	: _buffer(INITIAL_CAPACITY)
+	, _begin(0)
+	, _end(0)
+	, _maxMessageSize(maxMessageSize)
+{
+}
+
+qint64 ReceiveBuffer::readFrom(QIODevice* device)
+{
+	qint64 total = 0;
+	qint64 available;
+	while ((available = device->bytesAvailable()) > 0)
+	{
+		reserveTail(static_cast<int>(qMin(available, qint64(_maxMessageSize) + HEADER_SIZE)));
+
+		const qint64 count = device->read(reinterpret_cast<char*>(_buffer.data() + _end), _buffer.size() - _end);
+		if (count <= 0)
+		{
+			break;
+		}
+		_end += static_cast<int>(count);
+		total += count;
+	}
+	return total;
+}
+
+ReceiveBuffer::Result ReceiveBuffer::nextMessage(const uint8_t*& data, uint32_t& size)
+{
+	if (_end - _begin < HEADER_SIZE)
+	{
+		return Result::Incomplete;
+	}
+
+	const uint8_t* header = _buffer.constData() + _begin;
+	const uint32_t messageSize = (uint32_t(header[0]) << 24) | (uint32_t(header[1]) << 16) | (uint32_t(header[2]) << 8) | uint32_t(header[3]);
+	if (messageSize > _maxMessageSize)
+	{
+		return Result::Invalid;
+	}
+
+	if (static_cast<uint32_t>(_end - _begin - HEADER_SIZE) < messageSize)
+	{
+		// make sure the rest of the message fits when it arrives
+		reserveTail(static_cast<int>(messageSize) + HEADER_SIZE - (_end - _begin));
+		return Result::Incomplete;
+	}
+
+	data = _buffer.constData() + _begin + HEADER_SIZE;
+	size = messageSize;
+
+	_begin += HEADER_SIZE + static_cast<int>(messageSize);
+	if (_begin == _end)
+	{
+		// the common case, no data to move
+		_begin = _end = 0;
+	}
+	return Result::Message;
+}
+
+void ReceiveBuffer::reserveTail(int size)
+{
+	if (_buffer.size() - _end >= size)
+	{
+		return;
+	}
+
+	// move the unread rest to the front
+	if (_begin > 0)
+	{
+		memmove(_buffer.data(), _buffer.constData() + _begin, static_cast<size_t>(_end - _begin));
+		_end -= _begin;
+		_begin = 0;
+	}
+
+	if (_buffer.size() - _end < size)
+	{
+		_buffer.resize(qMax(_buffer.size() * 2, _end + size));
+	}
+}
@@ -5,6 +5,16 @@
 
 namespace RGBW {
 
+namespace {
+
+// http://forum.garagecube.com/viewtopic.php?t=10178
+// warm white
+const double WARM_FACTORS[3] = { 0.274, 0.454, 2.333 };
+// cold white
+const double COOL_FACTORS[3] = { 0.299, 0.587, 0.114 };
+
+}
+
 WhiteAlgorithm stringToWhiteAlgorithm(const QString& str)
 {
 	if (str == "subtract_minimum")
@@ -41,11 +51,9 @@ void Rgb_to_Rgbw(ColorRgb input, ColorRgbw * output, WhiteAlgorithm algorithm)
 
 		case WhiteAlgorithm::SUB_MIN_WARM_ADJUST:
 		{
-			// http://forum.garagecube.com/viewtopic.php?t=10178
-			// warm white
-			const double F1(0.274);
-			const double F2(0.454);
-			const double F3(2.333);
+			const double F1(WARM_FACTORS[0]);
+			const double F2(WARM_FACTORS[1]);
+			const double F3(WARM_FACTORS[2]);
 
 			output->white = static_cast<uint8_t>(qMin(input.red*F1,qMin(input.green*F2,input.blue*F3)));
 			output->red   = input.red   - static_cast<uint8_t>(output->white/F1);
@@ -56,11 +64,9 @@ void Rgb_to_Rgbw(ColorRgb input, ColorRgbw * output, WhiteAlgorithm algorithm)
 
 		case WhiteAlgorithm::SUB_MIN_COOL_ADJUST:
 		{
-			// http://forum.garagecube.com/viewtopic.php?t=10178
-			// cold white
-			const double F1(0.299);
-			const double F2(0.587);
-			const double F3(0.114);
+			const double F1(COOL_FACTORS[0]);
+			const double F2(COOL_FACTORS[1]);
+			const double F3(COOL_FACTORS[2]);
 
 			output->white = static_cast<uint8_t>(qMin(input.red*F1,qMin(input.green*F2,input.blue*F3)));
 			output->red   = input.red   - static_cast<uint8_t>(output->white/F1);
@@ -82,4 +88,82 @@ void Rgb_to_Rgbw(ColorRgb input, ColorRgbw * output, WhiteAlgorithm algorithm)
 	}
 }
 
+RgbwConverter::RgbwConverter(WhiteAlgorithm algorithm)
+{
+	setAlgorithm(algorithm);
+}
+
+void RgbwConverter::setAlgorithm(WhiteAlgorithm algorithm)
+{
+	_algorithm = (algorithm == WhiteAlgorithm::INVALID) ? WhiteAlgorithm::WHITE_OFF : algorithm;
+
+	for (int channel = 0; channel < 3; ++channel)
+	{
+		for (int value = 0; value < 256; ++value)
+		{
+			switch (_algorithm)
+			{
+				case WhiteAlgorithm::SUBTRACT_MINIMUM:
+					_white[channel][value] = static_cast<uint8_t>(value);
+					_subtract[channel][value] = static_cast<uint8_t>(value);
+					break;
+
+				case WhiteAlgorithm::SUB_MIN_WARM_ADJUST:
+				case WhiteAlgorithm::SUB_MIN_COOL_ADJUST:
+				{
+					// truncating each share equals truncating their minimum, white levels above 255 never win
+					const double factor = (_algorithm == WhiteAlgorithm::SUB_MIN_WARM_ADJUST) ? WARM_FACTORS[channel] : COOL_FACTORS[channel];
+					_white[channel][value] = static_cast<uint8_t>(qMin(value * factor, 255.0));
+					_subtract[channel][value] = static_cast<uint8_t>(qMin(value / factor, 255.0));
+					break;
+				}
+
+				default:
+					_white[channel][value] = 0;
+					_subtract[channel][value] = 0;
+					break;
+			}
+		}
+	}
+}
+
+void RgbwConverter::convert(const ColorRgb* input, size_t count, uint8_t* output) const
+{
+	switch (_algorithm)
+	{
+		// plain loops for the algorithms without factors, the compiler vectorizes them
+		case WhiteAlgorithm::SUBTRACT_MINIMUM:
+			for (size_t i = 0; i < count; ++i, output += 4)
+			{
+				const uint8_t white = qMin(qMin(input[i].red, input[i].green), input[i].blue);
+				output[0] = input[i].red   - white;
+				output[1] = input[i].green - white;
+				output[2] = input[i].blue  - white;
+				output[3] = white;
+			}
+			break;
+
+		case WhiteAlgorithm::WHITE_OFF:
+			for (size_t i = 0; i < count; ++i, output += 4)
+			{
+				output[0] = input[i].red;
+				output[1] = input[i].green;
+				output[2] = input[i].blue;
+				output[3] = 0;
+			}
+			break;
+
+		default:
+			for (size_t i = 0; i < count; ++i, output += 4)
+			{
+				const ColorRgbw color = convert(input[i]);
+				output[0] = color.red;
+				output[1] = color.green;
+				output[2] = color.blue;
+				output[3] = color.white;
+			}
+			break;
+	}
+}
+
 };
@@ -1,6 +1,7 @@
 
 #include "StaticFileServing.h"
 #include <utils/QStringUtils.h>
+#include <utils/Metrics.h>
 
 #include <QStringBuilder>
 #include <QUrlQuery>
@@ -16,6 +17,7 @@ StaticFileServing::StaticFileServing (QObject * parent)
 	, _baseUrl ()
 	, _cgi(this)
 	, _log(Logger::getInstance("WEBSERVER"))
+	, _metricsEnabled(false)
 {
 	Q_INIT_RESOURCE(WebConfig);
 
@@ -41,6 +43,11 @@ void StaticFileServing::setSSDPDescription(const QString& desc)
 		_ssdpDescription = desc.toLocal8Bit();
 }
 
+void StaticFileServing::setMetricsEnabled(bool enable)
+{
+	_metricsEnabled = enable;
+}
+
 void StaticFileServing::printErrorToReply (QtHttpReply * reply, QtHttpReply::StatusCode code, QString errorMessage)
 {
 	reply->setStatusCode(code);
@@ -106,6 +113,12 @@ void StaticFileServing::onRequestNeedsReply (QtHttpRequest * request, QtHttpRepl
 				reply->appendRawData (_ssdpDescription);
 				return;
 			}
+			else if(uri_parts.at(0) == "metrics" && _metricsEnabled)
+			{
+				reply->addHeader ("Content-Type", "text/plain; version=0.0.4");
+				reply->appendRawData (Metrics::toPrometheus());
+				return;
+			}
 		}
 
 		QFileInfo info(_baseUrl % "/" % path);
@@ -28,6 +28,11 @@ public:
 	/// @param The description
 	///
 	void setSSDPDescription(const QString& desc);
+	///
+	/// @brief Enable the Prometheus metrics at /metrics
+	/// @param enable True to serve the metrics, otherwise clients get a NotFound
+	///
+	void setMetricsEnabled(bool enable);
 
 public slots:
 	void onRequestNeedsReply  (QtHttpRequest * request, QtHttpReply * reply);
@@ -38,6 +43,7 @@ private:
 	CgiHandler      _cgi;
 	Logger        * _log;
 	QByteArray      _ssdpDescription;
+	bool            _metricsEnabled;
 
 	void printErrorToReply (QtHttpReply * reply, QtHttpReply::StatusCode code, QString errorMessage);
 
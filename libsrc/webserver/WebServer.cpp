@@ -109,6 +109,7 @@ void WebServer::handleSettingsUpdate(settings::type type, const QJsonDocument& c
 
 		Debug(_log, "Set document root to: %s", _baseUrl.toUtf8().constData());
 		_staticFileServing->setBaseUrl(_baseUrl);
+		_staticFileServing->setMetricsEnabled(obj["metrics"].toBool(false));
 
 		// ssl different port
 		quint16 newPort = _useSsl ? obj["sslPort"].toInt(WEBSERVER_DEFAULT_PORT) : obj["port"].toInt(WEBSERVER_DEFAULT_PORT);
@@ -57,6 +57,7 @@ int main(int argc, char ** argv)
 		Option         & argAddress			= parser.add<Option>       ('a', "address",        "The hostname or IP-address (IPv4 or IPv6) of the hyperion server.\nDefault host: %1, port: 19400.\nSample addresses:\nHost : hyperion.fritz.box\nIPv4 : 127.0.0.1:19400\nIPv6 : [2001:1:2:3:4:5:6:7]", "127.0.0.1");
 		IntOption      & argPriority		= parser.add<IntOption>    ('p', "priority",       "Use the provided priority channel (suggested 100-199) [default: %1]", "150");
 		BooleanOption  & argSkipReply		= parser.add<BooleanOption>(0x0, "skip-reply",     "Do not receive and check reply messages from Hyperion");
+		BooleanOption  & argUdp      		= parser.add<BooleanOption>(0x0, "udp",            "Send images over UDP, requires UDP enabled on the Hyperion Flatbuffers server");
 
 		BooleanOption  & argScreenshot		= parser.add<BooleanOption>(0x0, "screenshot",     "Take a single screenshot, save it to file and quit");
 
@@ -134,6 +135,7 @@ int main(int argc, char ** argv)
 
 			// Create the Flabuf-connection
 			FlatBufferConnection flatbuf("AML Standalone", host, argPriority.getInt(parser), parser.isSet(argSkipReply), port);
+			flatbuf.setUdpTransport(parser.isSet(argUdp));
 
 			// Connect the screen capturing to flatbuf connection processing
 			QObject::connect(&amlWrapper, SIGNAL(sig_screenshot(const Image<ColorRgb> &)), &flatbuf, SLOT(setImage(Image<ColorRgb>)));
@@ -11,6 +11,7 @@
 #include <QJsonDocument>
 #include <QHostInfo>
 #include <QUrl>
+#include <QElapsedTimer>
 
 // hyperion-remote includes
 #include "JsonConnection.h"
@@ -519,6 +520,150 @@ void JsonConnection::setInstance(int instance)
 	parseReply(reply);
 }
 
+int JsonConnection::sendBatch(std::istream & input, double rate)
+{
+	// commands sent ahead of their replies, the server handles them in order
+	const int maxPending = 64;
+	const int replyTimeout_ms = 30000;
+	const qint64 frameInterval_ns = (rate > 0) ? static_cast<qint64>(1e9 / rate) : 0;
+
+	QHash<int, int> pending;
+	int failed = 0;
+	int sent = 0;
+	int lineNumber = 0;
+	qint64 nextFrame_ns = 0;
+
+	QElapsedTimer clock;
+	clock.start();
+
+	std::string line;
+	while (std::getline(input, line))
+	{
+		++lineNumber;
+		const QByteArray data = QByteArray::fromStdString(line).trimmed();
+		if (data.isEmpty() || data.startsWith('#'))
+		{
+			continue;
+		}
+
+		QJsonParseError error;
+		QJsonObject command = QJsonDocument::fromJson(data, &error).object();
+		if (error.error != QJsonParseError::NoError || !command.contains("command"))
+		{
+			Error(_log, "Line %d: No valid json command: %s", lineNumber, QSTRING_CSTR(error.errorString()));
+			++failed;
+			continue;
+		}
+
+		// color and image commands are sent on the frame deadlines, replies are handled while waiting
+		const QString name = command["command"].toString();
+		if (frameInterval_ns > 0 && (name == "color" || name == "image"))
+		{
+			// the input stalled, continue from now instead of sending the missed frames at once
+			if (nextFrame_ns < clock.nsecsElapsed() - frameInterval_ns)
+			{
+				nextFrame_ns = clock.nsecsElapsed();
+			}
+
+			qint64 remaining_ns;
+			while ((remaining_ns = nextFrame_ns - clock.nsecsElapsed()) > 0)
+			{
+				failed += handleBatchReplies(pending, static_cast<int>((remaining_ns + 999999) / 1000000));
+			}
+			nextFrame_ns += frameInterval_ns;
+		}
+
+		if (pending.size() >= maxPending)
+		{
+			failed += waitForBatchReplies(pending, maxPending - 1, replyTimeout_ms);
+		}
+
+		const int tan = ++sent;
+		command["tan"] = tan;
+		QByteArray serializedMessage = QJsonDocument(command).toJson(QJsonDocument::Compact) + "\n";
+		if (_printJson)
+		{
+			std::cout << "Command: " << serializedMessage.constData();
+		}
+
+		if (_socket.write(serializedMessage) < 0)
+		{
+			throw std::runtime_error("Error while writing data to host");
+		}
+		_socket.flush();
+		pending.insert(tan, lineNumber);
+
+		// writes the command and handles replies already received
+		failed += handleBatchReplies(pending, 0);
+	}
+
+	failed += waitForBatchReplies(pending, 0, replyTimeout_ms);
+
+	Info(_log, "Sent %d commands in %.3f s, %d failed", sent, clock.elapsed() / 1000.0, failed);
+	return failed;
+}
+
+int JsonConnection::waitForBatchReplies(QHash<int, int> & pending, int maxPending, int timeout_ms)
+{
+	// a reply might arrive in several segments or after unrelated messages, only the deadline ends the wait
+	QElapsedTimer timer;
+	timer.start();
+
+	int failed = 0;
+	while (pending.size() > maxPending)
+	{
+		const qint64 remaining_ms = timeout_ms - timer.elapsed();
+		if (remaining_ms <= 0)
+		{
+			throw std::runtime_error("Timeout while waiting for replies from host");
+		}
+		failed += handleBatchReplies(pending, static_cast<int>(remaining_ms));
+	}
+	return failed;
+}
+
+int JsonConnection::handleBatchReplies(QHash<int, int> & pending, int timeout_ms)
+{
+	if (!_receiveBuffer.contains('\n'))
+	{
+		// also writes pending data of the socket
+		if (!_socket.waitForReadyRead(timeout_ms) && _socket.state() != QAbstractSocket::ConnectedState)
+		{
+			throw std::runtime_error("Connection to host lost");
+		}
+		_receiveBuffer += _socket.readAll();
+	}
+
+	int failed = 0;
+	int end;
+	while ((end = _receiveBuffer.indexOf('\n')) >= 0)
+	{
+		const QByteArray serializedReply = _receiveBuffer.left(end);
+		_receiveBuffer.remove(0, end + 1);
+
+		if (_printJson)
+		{
+			std::cout << "Reply: " << serializedReply.constData() << std::endl;
+		}
+
+		const QJsonObject reply = QJsonDocument::fromJson(serializedReply).object();
+		const int tan = reply["tan"].toInt();
+		if (!pending.contains(tan))
+		{
+			// not a reply to a batch command
+			continue;
+		}
+
+		const int lineNumber = pending.take(tan);
+		if (!reply["success"].toBool(false))
+		{
+			Error(_log, "Line %d: Command '%s' failed: %s", lineNumber, QSTRING_CSTR(reply["command"].toString()), QSTRING_CSTR(reply["error"].toString("No error info")));
+			++failed;
+		}
+	}
+	return failed;
+}
+
 QJsonObject JsonConnection::sendMessage(const QJsonObject & message)
 {
 	// serialize message
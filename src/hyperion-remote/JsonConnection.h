@@ -5,6 +5,10 @@
 #include <QImage>
 #include <QTcpSocket>
 #include <QJsonObject>
+#include <QHash>
+
+// stl includes
+#include <istream>
 
 //forward class decl
 class Logger;
@@ -190,6 +194,17 @@ public:
 	///
 	void setInstance(int instance);
 
+	///
+	/// Send newline delimited json commands over this connection without waiting for each reply.
+	/// Replies are matched by the tan, which is assigned per command. Empty lines and lines starting with '#' are skipped.
+	///
+	/// @param input The commands, e.g. a file or stdin
+	/// @param rate The rate in frames per second at which color and image commands are sent, unpaced if 0
+	///
+	/// @return The number of commands which failed
+	///
+	int sendBatch(std::istream & input, double rate);
+
 
 private:
 	///
@@ -210,6 +225,27 @@ private:
 	///
 	bool parseReply(const QJsonObject & reply);
 
+	///
+	/// Handle the replies of batch commands received within the given time
+	///
+	/// @param pending The line numbers of the commands waiting for a reply by their tan
+	/// @param timeout_ms The time to wait for a reply, 0 to handle the received replies only
+	///
+	/// @return The number of failed commands
+	///
+	int handleBatchReplies(QHash<int, int> & pending, int timeout_ms);
+
+	///
+	/// Handle the replies of batch commands until no more than the given number of commands are waiting
+	///
+	/// @param pending The line numbers of the commands waiting for a reply by their tan
+	/// @param maxPending The number of commands which may still wait for a reply
+	/// @param timeout_ms The time to wait for the replies
+	///
+	/// @return The number of failed commands
+	///
+	int waitForBatchReplies(QHash<int, int> & pending, int maxPending, int timeout_ms);
+
 	/// Flag for printing all send and received json-messages to the standard out
 	bool _printJson;
 
@@ -219,4 +255,7 @@ private:
 	/// The TCP-Socket with the connection to the server
 	QTcpSocket _socket;
 
+	/// Received data not yet handled in batch mode
+	QByteArray _receiveBuffer;
+
 };
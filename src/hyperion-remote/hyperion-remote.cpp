@@ -3,6 +3,7 @@
 #include <initializer_list>
 #include <limits>
 #include <iostream>
+#include <fstream>
 #include <stdlib.h>
 
 // Qt includes
@@ -134,6 +135,8 @@ int main(int argc, char * argv[])
 		BooleanOption   & argConfigGet          = parser.add<BooleanOption>(0x0, "configGet"              , "Print the current loaded Hyperion configuration file");
 		BooleanOption   & argSchemaGet          = parser.add<BooleanOption>(0x0, "schemaGet"              , "Print the JSON schema for Hyperion configuration");
 		Option          & argConfigSet          = parser.add<Option>       (0x0, "configSet"              , "Write to the actual loaded configuration file. Should be a JSON object string.");
+		Option          & argBatch              = parser.add<Option>       (0x0, "batch"                  , "Send newline delimited JSON commands from the given file or stdin (-) over a single connection without waiting for each reply");
+		DoubleOption    & argRate               = parser.add<DoubleOption> (0x0, "rate"                   , "Send color and image commands of --batch at the given rate in frames per second", QString(), 0.0, 1000.0);
 
 		BooleanOption   & argPrint              = parser.add<BooleanOption>(0x0, "print", "Print the JSON input and output messages on stdout");
 		BooleanOption   & argDebug              = parser.add<BooleanOption>(0x0, "debug", "Enable debug logging");
@@ -163,7 +166,7 @@ int main(int argc, char * argv[])
 		int commandCount = count({ parser.isSet(argColor), parser.isSet(argImage), parser.isSet(argEffect), parser.isSet(argCreateEffect), parser.isSet(argDeleteEffect),
 		    parser.isSet(argServerInfo), parser.isSet(argSysInfo),parser.isSet(argClear), parser.isSet(argClearAll), parser.isSet(argEnableComponent), parser.isSet(argDisableComponent), colorAdjust,
 		    parser.isSet(argSource), parser.isSet(argSourceAuto), parser.isSet(argOff), parser.isSet(argOn), parser.isSet(argConfigGet), parser.isSet(argSchemaGet), parser.isSet(argConfigSet),
-		    parser.isSet(argMapping),parser.isSet(argVideoMode) });
+		    parser.isSet(argMapping),parser.isSet(argVideoMode), parser.isSet(argBatch) });
 		if (commandCount != 1)
 		{
 			qWarning() << (commandCount == 0 ? "No command found." : "Multiple commands found.") << " Provide exactly one of the following options:";
@@ -182,6 +185,7 @@ int main(int argc, char * argv[])
 			showHelp(argSourceAuto);
 			showHelp(argConfigGet);
 			showHelp(argVideoMode);
+			showHelp(argBatch);
 			qWarning() << "or one or more of the available color modding operations:";
 			showHelp(argId);
 			showHelp(argBrightness);
@@ -321,6 +325,31 @@ int main(int argc, char * argv[])
 		{
 			connection.setVideoMode(argVideoMode.value(parser));
 		}
+		else if (parser.isSet(argBatch))
+		{
+			const double rate = parser.isSet(argRate) ? argRate.getDouble(parser) : 0.0;
+			const QString fileName = argBatch.value(parser);
+
+			int failed;
+			if (fileName == "-")
+			{
+				failed = connection.sendBatch(std::cin, rate);
+			}
+			else
+			{
+				std::ifstream file(fileName.toStdString());
+				if (!file)
+				{
+					throw std::runtime_error(QString("Unable to open batch file (%1)").arg(fileName).toStdString());
+				}
+				failed = connection.sendBatch(file, rate);
+			}
+
+			if (failed > 0)
+			{
+				return 1;
+			}
+		}
 		else if (colorAdjust)
 		{
 			connection.setAdjustment(
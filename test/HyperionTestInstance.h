@@ -0,0 +1,123 @@
+#pragma once
+
+// STL includes
+#include <atomic>
+#include <functional>
+#include <vector>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+
+// Hyperion includes
+#include <hyperion/Hyperion.h>
+#include <leddevice/LedDevice.h>
+#include <leddevice/LedDeviceWrapper.h>
+
+///
+/// Keeps the last written colors in memory and counts the writes of all instances
+///
+class LedDeviceMemory : public LedDevice
+{
+public:
+	explicit LedDeviceMemory(const QJsonObject& deviceConfig)
+		: LedDevice(deviceConfig)
+	{
+	}
+
+	static LedDevice* construct(const QJsonObject& deviceConfig)
+	{
+		return new LedDeviceMemory(deviceConfig);
+	}
+
+	static std::atomic<int>& writes()
+	{
+		static std::atomic<int> count(0);
+		return count;
+	}
+
+	static std::vector<ColorRgb> lastColors()
+	{
+		QMutexLocker lock(&mutex());
+		return colors();
+	}
+
+protected:
+	int write(const std::vector<ColorRgb>& ledValues) override
+	{
+		{
+			QMutexLocker lock(&mutex());
+			colors().assign(ledValues.begin(), ledValues.end());
+		}
+		writes().fetch_add(1, std::memory_order_relaxed);
+		return 0;
+	}
+
+private:
+	static QMutex& mutex()
+	{
+		static QMutex instance;
+		return instance;
+	}
+
+	static std::vector<ColorRgb>& colors()
+	{
+		static std::vector<ColorRgb> instance;
+		return instance;
+	}
+};
+
+///
+/// Runs instance 0 without the daemon, constructed like HyperionIManager does, but in the calling thread.
+/// The settings are read from the database, the DBManager root path has to be set before.
+///
+class HyperionTestInstance
+{
+public:
+	/// Make LedDeviceMemory available as device type "testmemory"
+	static void registerDevice()
+	{
+		LedDeviceWrapper::addToDeviceMap("testmemory", LedDeviceMemory::construct);
+	}
+
+	static QJsonObject deviceConfig(int ledCount)
+	{
+		return QJsonObject{ { "type", "testmemory" }, { "hardwareLedCount", ledCount }, { "colorOrder", "rgb" }, { "latchTime", 0 }, { "rewriteTime", 0 } };
+	}
+
+	static Hyperion* createInstance()
+	{
+		Hyperion* hyperion = new Hyperion(0);
+		hyperion->start();
+		return hyperion;
+	}
+
+	static bool isDeviceEnabled(const Hyperion* hyperion)
+	{
+		return hyperion->_ledDeviceWrapper->enabled();
+	}
+
+	///
+	/// Process events until the condition is met
+	/// @return False, if the timeout passed before
+	///
+	static bool waitFor(const std::function<bool()>& condition, int timeout_ms)
+	{
+		QElapsedTimer timer;
+		timer.start();
+		while (!condition())
+		{
+			if (timer.elapsed() > timeout_ms)
+			{
+				return false;
+			}
+			QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+			QThread::msleep(1);
+		}
+		return true;
+	}
+};
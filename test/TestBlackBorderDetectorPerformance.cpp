@@ -0,0 +1,91 @@
+// STL includes
+#include <iostream>
+
+// Qt includes
+#include <QElapsedTimer>
+
+// Hyperion includes
+#include <utils/ColorRgb.h>
+#include <utils/ColorRgba.h>
+
+// Blackborder includes
+#include <blackborder/BlackBorderDetector.h>
+
+using namespace hyperion;
+
+static const int ITERATIONS = 1000;
+
+template <typename Pixel_T>
+Image<Pixel_T> createImage(unsigned width, unsigned height, unsigned topBorder, unsigned leftBorder, const Pixel_T & color)
+{
+	Image<Pixel_T> image(width, height);
+	for (unsigned y=0; y<image.height(); ++y)
+	{
+		for (unsigned x=0; x<image.width(); ++x)
+		{
+			const bool isBorder = y < topBorder || y >= height - topBorder || x < leftBorder || x >= width - leftBorder;
+			image(x,y) = isBorder ? Pixel_T::BLACK : color;
+		}
+	}
+	return image;
+}
+
+template <typename Pixel_T>
+void measure(const char * name, const Image<Pixel_T> & image)
+{
+	BlackBorderDetector detector(0.05);
+	int checksum = 0;
+
+	std::cout << name << " [" << image.width() << "x" << image.height() << "]" << std::endl;
+
+	QElapsedTimer timer;
+	timer.start();
+	for (int i=0; i<ITERATIONS; ++i)
+	{
+		checksum += detector.process(image).horizontalSize;
+	}
+	std::cout << "  default:   " << timer.nsecsElapsed() / 1000 / ITERATIONS << " us/frame" << std::endl;
+
+	timer.restart();
+	for (int i=0; i<ITERATIONS; ++i)
+	{
+		checksum += detector.process_classic(image).horizontalSize;
+	}
+	std::cout << "  classic:   " << timer.nsecsElapsed() / 1000 / ITERATIONS << " us/frame" << std::endl;
+
+	timer.restart();
+	for (int i=0; i<ITERATIONS; ++i)
+	{
+		checksum += detector.process_osd(image).horizontalSize;
+	}
+	std::cout << "  osd:       " << timer.nsecsElapsed() / 1000 / ITERATIONS << " us/frame" << std::endl;
+
+	timer.restart();
+	for (int i=0; i<ITERATIONS; ++i)
+	{
+		checksum += detector.process_letterbox(image).horizontalSize;
+	}
+	std::cout << "  letterbox: " << timer.nsecsElapsed() / 1000 / ITERATIONS << " us/frame" << std::endl;
+
+	// keep the compiler from dropping the detection
+	if (checksum == 42)
+	{
+		std::cout << std::endl;
+	}
+}
+
+int main()
+{
+	const ColorRgb rgb = {120, 80, 40};
+	const ColorRgba rgba = {120, 80, 40, 255};
+
+	measure("RGB, no border",             createImage<ColorRgb>(1920, 1080, 0, 0, rgb));
+	measure("RGB, letterbox",             createImage<ColorRgb>(1920, 1080, 140, 0, rgb));
+	measure("RGB, pillarbox",             createImage<ColorRgb>(1920, 1080, 0, 240, rgb));
+	measure("RGB, black (worst case)",    createImage<ColorRgb>(1920, 1080, 0, 0, ColorRgb::BLACK));
+	measure("RGB, decimated letterbox",   createImage<ColorRgb>(240, 135, 17, 0, rgb));
+	measure("RGBA, letterbox (scalar)",   createImage<ColorRgba>(1920, 1080, 140, 0, rgba));
+	measure("RGBA, black (scalar)",       createImage<ColorRgba>(1920, 1080, 0, 0, ColorRgba::BLACK));
+
+	return 0;
+}
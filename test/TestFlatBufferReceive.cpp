@@ -0,0 +1,87 @@
+// STL includes
+#include <iostream>
+#include <thread>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+// Hyperion includes
+#include <flatbufserver/FlatBufferClient.h>
+#include <flatbufserver/FlatBufferConnection.h>
+
+// Streams 1080p images over loopback to a Flatbuffers server connection as fast as it receives them
+// and reports the frames per second of the receive path (reading, verifying and decoding).
+// Usage: test_flatbufferreceive [frames] [width] [height]
+
+int main(int argc, char** argv)
+{
+	QCoreApplication app(argc, argv);
+	Logger::setLogLevel(Logger::WARNING);
+
+	const int frames = (argc > 1) ? QString(argv[1]).toInt() : 500;
+	const unsigned width = (argc > 2) ? QString(argv[2]).toUInt() : 1920;
+	const unsigned height = (argc > 3) ? QString(argv[3]).toUInt() : 1080;
+
+	QTcpServer server;
+	if (!server.listen(QHostAddress::LocalHost))
+	{
+		std::cerr << "Failed to start the server" << std::endl;
+		return 1;
+	}
+
+	Image<ColorRgb> image(width, height);
+	for (unsigned i = 0; i < width * height; ++i)
+	{
+		image.memptr()[i] = ColorRgb{ uint8_t(i), uint8_t(i >> 8), uint8_t(i >> 16) };
+	}
+	const QByteArray message = FlatBufferConnection::encodeImage(image);
+
+	int received = 0;
+	bool valid = true;
+	QElapsedTimer timer;
+
+	QObject::connect(&server, &QTcpServer::newConnection, [&]() {
+		QTcpSocket* socket = server.nextPendingConnection();
+		FlatBufferClient* client = new FlatBufferClient(socket, 60, &app);
+		QObject::connect(client, &FlatBufferClient::setGlobalInputImage, [&](int, const Image<ColorRgb>& frame, int) {
+			valid &= (frame.width() == width && frame.height() == height && frame.memptr()[width + 1] == image.memptr()[width + 1]);
+			if (++received == frames)
+			{
+				app.quit();
+			}
+		});
+		timer.start();
+	});
+
+	// the sender writes as fast as the receiver reads
+	const quint16 port = server.serverPort();
+	std::thread sender([&]() {
+		QTcpSocket socket;
+		socket.connectToHost(QHostAddress::LocalHost, port);
+		if (!socket.waitForConnected(5000))
+		{
+			QMetaObject::invokeMethod(&app, "quit", Qt::QueuedConnection);
+			return;
+		}
+		for (int i = 0; i < frames; ++i)
+		{
+			socket.write(message);
+			socket.waitForBytesWritten(-1);
+			// discard the replies
+			socket.readAll();
+		}
+	});
+
+	app.exec();
+	const qint64 elapsed = timer.nsecsElapsed();
+	sender.join();
+
+	const double seconds = elapsed / 1e9;
+	std::cout << "Received " << received << " frames of " << width << "x" << height << " in " << seconds << " s" << std::endl;
+	std::cout << "  " << received / seconds << " frames per second, " << received * message.size() / seconds / (1024 * 1024) << " MB/s" << std::endl;
+
+	return (valid && received == frames) ? 0 : 1;
+}
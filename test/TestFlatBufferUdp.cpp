@@ -0,0 +1,137 @@
+// STL includes
+#include <iostream>
+#include <random>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QUdpSocket>
+
+// Hyperion includes
+#include <flatbufserver/FlatBufferDatagram.h>
+
+// Sends messages of image size over loopback UDP, fragmented like the Flatbuffers UDP transport.
+// Datagrams are dropped and delayed at random, the receiver must deliver complete and correct messages in order only.
+// Usage: test_flatbufferudp [loss in percent] [messages]
+
+namespace {
+
+const int IMAGE_SIZE = 160 * 90 * 3;
+const int COLOR_SIZE = 64;
+const quint8 PRIORITY = 150;
+
+QByteArray createMessage(quint32 sequence)
+{
+	// every fourth message fits into a single datagram
+	QByteArray message((sequence % 4 == 0) ? COLOR_SIZE : IMAGE_SIZE, 0);
+	for (int i = 0; i < message.size(); ++i)
+	{
+		message[i] = static_cast<char>((sequence * 31 + static_cast<quint32>(i)) & 0xFF);
+	}
+	return message;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	QCoreApplication app(argc, argv);
+
+	const int loss = (argc > 1) ? QString(argv[1]).toInt() : 2;
+	const int messages = (argc > 2) ? QString(argv[2]).toInt() : 1000;
+
+	QUdpSocket receiver;
+	if (!receiver.bind(QHostAddress::LocalHost, 0))
+	{
+		std::cerr << "Failed to bind the receiver" << std::endl;
+		return 1;
+	}
+	receiver.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 2 * 1024 * 1024);
+	QUdpSocket sender;
+
+	std::mt19937 random(42);
+	std::uniform_int_distribution<int> percent(0, 99);
+
+	FlatBufferDatagram::Reassembler reassembler;
+	QByteArray delayed;
+	qint64 lastDelivered = -1;
+	int delivered = 0;
+	int corrupt = 0;
+	int datagramsSent = 0;
+	int datagramsLost = 0;
+
+	QElapsedTimer timer;
+	timer.start();
+	for (quint32 sequence = 0; sequence < static_cast<quint32>(messages); ++sequence)
+	{
+		const QByteArray message = createMessage(sequence);
+		const QVector<QByteArray> datagrams = FlatBufferDatagram::fragment(message.constData(), message.size(), PRIORITY, sequence);
+
+		for (const QByteArray& datagram : datagrams)
+		{
+			++datagramsSent;
+			const int chance = percent(random);
+			if (chance < loss)
+			{
+				++datagramsLost;
+				continue;
+			}
+			// hold back a datagram, it arrives after the next message
+			if (chance >= 99 && delayed.isEmpty())
+			{
+				delayed = datagram;
+				continue;
+			}
+			sender.writeDatagram(datagram, QHostAddress::LocalHost, receiver.localPort());
+		}
+		if (!delayed.isEmpty() && sequence % 2 == 1)
+		{
+			sender.writeDatagram(delayed, QHostAddress::LocalHost, receiver.localPort());
+			delayed.clear();
+		}
+
+		while (receiver.hasPendingDatagrams() || receiver.waitForReadyRead(5))
+		{
+			QByteArray datagram(static_cast<int>(receiver.pendingDatagramSize()), 0);
+			receiver.readDatagram(datagram.data(), datagram.size());
+			if (!FlatBufferDatagram::isValid(datagram) || FlatBufferDatagram::priority(datagram) != PRIORITY)
+			{
+				++corrupt;
+				continue;
+			}
+
+			if (reassembler.add(datagram))
+			{
+				// identify the message by its content, it has to be newer than the previous one
+				const QByteArray& received = reassembler.message();
+				qint64 receivedSequence = -1;
+				for (qint64 candidate = lastDelivered + 1; candidate <= sequence; ++candidate)
+				{
+					if (received == createMessage(static_cast<quint32>(candidate)))
+					{
+						receivedSequence = candidate;
+						break;
+					}
+				}
+
+				if (receivedSequence < 0)
+				{
+					++corrupt;
+				}
+				else
+				{
+					lastDelivered = receivedSequence;
+					++delivered;
+				}
+			}
+		}
+	}
+
+	const qint64 elapsed = timer.elapsed();
+	std::cout << "Sent " << messages << " messages in " << datagramsSent << " datagrams, " << datagramsLost << " lost (" << loss << "%)" << std::endl;
+	std::cout << "  delivered:  " << delivered << " in order, " << corrupt << " corrupt or out of order" << std::endl;
+	std::cout << "  dropped:    " << reassembler.incompleteMessages() << " incomplete messages, " << reassembler.staleDatagrams() << " stale datagrams" << std::endl;
+	std::cout << "  duration:   " << elapsed << " ms" << std::endl;
+
+	return (corrupt == 0 && delivered > 0) ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+// STL includes
+#include <cstring>
+#include <iostream>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTemporaryFile>
+
+// Hyperion includes
+#include <grabber/FramebufferFrameGrabber.h>
+#include <utils/Logger.h>
+
+// Grabs a file-backed fake framebuffer: checks the pixel conversion of the 16/24/32 bpp layouts,
+// that screen updates are seen without mapping the device again, that a mode change is followed, and measures the grab time.
+// Usage: test_framebuffergrabber [frames]
+
+namespace {
+
+const unsigned WIDTH = 640;
+const unsigned HEIGHT = 360;
+const unsigned MAX_BYTES_PER_PIXEL = 4;
+
+///
+/// Framebuffer grabber reporting a given screen mode for a regular file, which can't answer the fbdev ioctls
+///
+class FakeFramebufferGrabber : public FramebufferFrameGrabber
+{
+public:
+	explicit FakeFramebufferGrabber(const QString & device)
+		: FramebufferFrameGrabber(device)
+	{
+		setMode(32, 16);
+	}
+
+	void setMode(unsigned bitsPerPixel, unsigned redOffset)
+	{
+		memset(&_fakeFixInfo, 0, sizeof(_fakeFixInfo));
+		memset(&_fakeVarInfo, 0, sizeof(_fakeVarInfo));
+		_fakeVarInfo.xres = WIDTH;
+		_fakeVarInfo.yres = HEIGHT;
+		_fakeVarInfo.bits_per_pixel = bitsPerPixel;
+		_fakeVarInfo.red.offset = redOffset;
+		_fakeFixInfo.line_length = WIDTH * bitsPerPixel / 8;
+		_fakeFixInfo.smem_len = WIDTH * HEIGHT * MAX_BYTES_PER_PIXEL;
+	}
+
+protected:
+	bool queryFixInfo(int, struct fb_fix_screeninfo & fixInfo) const override
+	{
+		fixInfo = _fakeFixInfo;
+		return true;
+	}
+
+	bool queryVarInfo(int, struct fb_var_screeninfo & varInfo) const override
+	{
+		varInfo = _fakeVarInfo;
+		return true;
+	}
+
+private:
+	struct fb_fix_screeninfo _fakeFixInfo;
+	struct fb_var_screeninfo _fakeVarInfo;
+};
+
+/// Color of a pixel, representable in RGB565
+ColorRgb pattern(unsigned x, unsigned y, uint8_t seed)
+{
+	return ColorRgb{ static_cast<uint8_t>((x + seed) & 0xF8), static_cast<uint8_t>((y + seed) & 0xFC), static_cast<uint8_t>((x ^ y) & 0xF8) };
+}
+
+/// Fill the fake framebuffer with the pattern in the given layout
+void fill(QFile & file, unsigned bitsPerPixel, unsigned redOffset, uint8_t seed)
+{
+	const unsigned bytes = bitsPerPixel / 8;
+	QByteArray data(static_cast<int>(WIDTH * HEIGHT * MAX_BYTES_PER_PIXEL), 0);
+	uint8_t * pixel = reinterpret_cast<uint8_t*>(data.data());
+	for (unsigned y = 0; y < HEIGHT; ++y)
+	{
+		for (unsigned x = 0; x < WIDTH; ++x, pixel += bytes)
+		{
+			const ColorRgb rgb = pattern(x, y, seed);
+			if (bitsPerPixel == 16)
+			{
+				const unsigned value = ((rgb.red >> 3) << 11) | ((rgb.green >> 2) << 5) | (rgb.blue >> 3);
+				pixel[0] = static_cast<uint8_t>(value);
+				pixel[1] = static_cast<uint8_t>(value >> 8);
+			}
+			else if (redOffset == 0)
+			{
+				pixel[0] = rgb.red;
+				pixel[1] = rgb.green;
+				pixel[2] = rgb.blue;
+			}
+			else
+			{
+				pixel[0] = rgb.blue;
+				pixel[1] = rgb.green;
+				pixel[2] = rgb.red;
+			}
+		}
+	}
+	file.seek(0);
+	file.write(data);
+	file.flush();
+}
+
+bool verify(FramebufferFrameGrabber & grabber, const char * name, uint8_t seed)
+{
+	Image<ColorRgb> image;
+	if (grabber.grabFrame(image) < 0 || image.width() != WIDTH || image.height() != HEIGHT)
+	{
+		std::cout << name << ": grab failed" << std::endl;
+		return false;
+	}
+
+	for (unsigned y = 0; y < HEIGHT; ++y)
+	{
+		for (unsigned x = 0; x < WIDTH; ++x)
+		{
+			const ColorRgb expected = pattern(x, y, seed);
+			if (image(x, y) != expected)
+			{
+				std::cout << name << ": pixel " << x << "," << y << " is " << image(x, y) << " instead of " << expected << std::endl;
+				return false;
+			}
+		}
+	}
+	std::cout << name << ": ok" << std::endl;
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	QCoreApplication app(argc, argv);
+	Logger::setLogLevel(Logger::WARNING);
+
+	const int frames = (argc > 1) ? QString(argv[1]).toInt() : 1000;
+
+	QTemporaryFile file;
+	if (!file.open())
+	{
+		std::cerr << "Failed to create the fake framebuffer" << std::endl;
+		return 1;
+	}
+
+	FakeFramebufferGrabber grabber(file.fileName());
+	grabber.setPixelDecimation(1);
+
+	bool ok = true;
+	fill(file, 32, 16, 0);
+	ok &= grabber.setupScreen();
+	ok &= verify(grabber, "BGR32", 0);
+
+	// the mapping follows the screen content
+	fill(file, 32, 16, 7);
+	ok &= verify(grabber, "BGR32 update", 7);
+
+	// mode changes are detected on the next grab
+	const struct { unsigned bitsPerPixel; unsigned redOffset; const char * name; } modes[] = {
+		{ 32, 0,  "RGB32" },
+		{ 24, 16, "BGR24" },
+		{ 16, 11, "BGR16" }
+	};
+	for (const auto & mode : modes)
+	{
+		grabber.setMode(mode.bitsPerPixel, mode.redOffset);
+		fill(file, mode.bitsPerPixel, mode.redOffset, 3);
+		ok &= verify(grabber, mode.name, 3);
+	}
+
+	for (unsigned bitsPerPixel : { 16u, 24u, 32u })
+	{
+		grabber.setMode(bitsPerPixel, 16);
+		fill(file, bitsPerPixel, 16, 0);
+
+		for (int decimation : { 1, 8 })
+		{
+			grabber.setPixelDecimation(decimation);
+			Image<ColorRgb> image;
+			QElapsedTimer timer;
+			timer.start();
+			for (int i = 0; i < frames; ++i)
+			{
+				grabber.grabFrame(image);
+			}
+			std::cout << bitsPerPixel << " bpp, decimation " << decimation << ": "
+					  << timer.nsecsElapsed() / 1000 / qMax(frames, 1) << " us per frame" << std::endl;
+		}
+		grabber.setPixelDecimation(1);
+	}
+
+	return ok ? 0 : 1;
+}
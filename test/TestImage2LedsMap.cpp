@@ -26,9 +26,9 @@ int main()
 	const ColorRgb testColor = {64, 123, 12};
 
 	Image<ColorRgb> image(64, 64, testColor);
-	hyperion::ImageToLedsMap map(64, 64, 0, 0, ledString.leds());
+	hyperion::ImageToLedsMap map(64, 64, 0, 0, ledString);
 
-	std::vector<ColorRgb> ledColors(ledString.leds().size());
+	std::vector<ColorRgb> ledColors(ledString.size());
 	map.getMeanLedColor(image, ledColors);
 
 	std::cout << "[";
@@ -0,0 +1,142 @@
+// STL includes
+#include <iostream>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QVector>
+
+// Hyperion includes
+#include <forwarder/JsonForwardConnection.h>
+#include <utils/Logger.h>
+
+// Forwards color messages to a local stand-in JSON server and to an unreachable target at the same time.
+// Measures the time the forwarding calls take and the latency until the stand-in server received the message.
+// Usage: test_jsonforwarder [messages] [unreachable host]
+
+namespace {
+
+const int SEND_INTERVAL_MS = 20;
+const int PRIORITIES = 4;
+
+///
+/// Accepts JSON connections, records the receive time of each message by its tan and replies like Hyperion
+///
+class StandInServer : public QTcpServer
+{
+public:
+	StandInServer(const QElapsedTimer & clock, QVector<qint64> & received)
+		: _clock(clock)
+		, _received(received)
+	{
+		connect(this, &QTcpServer::newConnection, this, [this]() {
+			QTcpSocket * socket = nextPendingConnection();
+			connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+				while (socket->canReadLine())
+				{
+					const QJsonObject message = QJsonDocument::fromJson(socket->readLine()).object();
+					const int tan = message["tan"].toInt(-1);
+					if (tan >= 0 && tan < _received.size())
+					{
+						_received[tan] = _clock.nsecsElapsed();
+					}
+					socket->write("{\"command\":\"color\",\"success\":true,\"tan\":" + QByteArray::number(tan) + "}\n");
+				}
+			});
+		});
+	}
+
+private:
+	const QElapsedTimer & _clock;
+	QVector<qint64> & _received;
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	QCoreApplication app(argc, argv);
+	Logger::setLogLevel(Logger::WARNING);
+
+	const int messages = (argc > 1) ? QString(argv[1]).toInt() : 250;
+	// not routed, connection attempts are never answered
+	const QHostAddress unreachableHost((argc > 2) ? QString(argv[2]) : QString("10.255.255.1"));
+
+	QElapsedTimer clock;
+	clock.start();
+	QVector<qint64> sent(messages, -1);
+	QVector<qint64> received(messages, -1);
+
+	StandInServer server(clock, received);
+	if (!server.listen(QHostAddress::LocalHost))
+	{
+		std::cerr << "Failed to start the stand-in server" << std::endl;
+		return 1;
+	}
+
+	JsonForwardConnection reachable(QHostAddress::LocalHost, server.serverPort());
+	JsonForwardConnection unreachable(unreachableHost, 19444);
+
+	qint64 callTotal = 0;
+	qint64 callMax = 0;
+	int count = 0;
+
+	QTimer sender;
+	sender.setInterval(SEND_INTERVAL_MS);
+	QObject::connect(&sender, &QTimer::timeout, [&]() {
+		if (count == messages)
+		{
+			sender.stop();
+			// let the last messages arrive
+			QTimer::singleShot(500, &app, &QCoreApplication::quit);
+			return;
+		}
+
+		QJsonObject message;
+		message["command"] = "color";
+		message["priority"] = 1 + count % PRIORITIES;
+		message["color"] = QJsonArray{ count % 256, 0, 255 - count % 256 };
+		message["tan"] = count;
+
+		const qint64 start = clock.nsecsElapsed();
+		sent[count] = start;
+		unreachable.sendMessage(message);
+		reachable.sendMessage(message);
+		const qint64 duration = clock.nsecsElapsed() - start;
+
+		callTotal += duration;
+		callMax = qMax(callMax, duration);
+		++count;
+	});
+	sender.start();
+	app.exec();
+
+	int delivered = 0;
+	qint64 latencyTotal = 0;
+	qint64 latencyMax = 0;
+	for (int i = 0; i < messages; ++i)
+	{
+		if (received[i] >= 0)
+		{
+			const qint64 latency = received[i] - sent[i];
+			latencyTotal += latency;
+			latencyMax = qMax(latencyMax, latency);
+			++delivered;
+		}
+	}
+
+	std::cout << "Forwarded " << count << " messages, the unreachable target is "
+			  << (unreachable.isConnected() ? "connected" : "not connected") << std::endl;
+	std::cout << "  forwarding call:  avg " << callTotal / 1000 / qMax(count, 1) << " us, max " << callMax / 1000 << " us" << std::endl;
+	std::cout << "  delivered:        " << delivered << ", superseded " << reachable.supersededMessages() << ", dropped " << reachable.droppedMessages() << std::endl;
+	std::cout << "  latency:          avg " << latencyTotal / 1000 / qMax(delivered, 1) << " us, max " << latencyMax / 1000 << " us" << std::endl;
+	std::cout << "  unreachable target: " << unreachable.pendingMessages() << " queued, superseded " << unreachable.supersededMessages()
+			  << ", dropped " << unreachable.droppedMessages() << std::endl;
+
+	return (delivered > 0) ? 0 : 1;
+}
@@ -0,0 +1,285 @@
+// STL includes
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+// Hyperion includes
+#include <db/DBManager.h>
+#include <hyperion/SettingsManager.h>
+#include <utils/ImageResampler.h>
+#include <utils/Logger.h>
+#include <utils/Metrics.h>
+#include <utils/PixelFormat.h>
+
+#include "HyperionTestInstance.h"
+
+// Runs the processing pipeline of a Hyperion instance headless: synthetic frames of the given resolution and pixel format
+// are converted like a grabber does, fed by setInputImage() and written to an in-memory device.
+// Reports the frame rates, the per stage latencies and the heap allocations as JSON.
+// Usage: test_pipelinebenchmark [frames] [width] [height] [pixel format|rgb] [leds] [smoothing 0|1]
+
+namespace {
+
+std::atomic<quint64> allocations(0);
+
+const int PRIORITY = 100;
+const int FRAME_VARIANTS = 8;
+
+///
+/// Places the LEDs evenly around a 16:9 screen, clockwise from the top left corner
+///
+QJsonArray createLayout(int ledCount)
+{
+	const int horizontal = qMax(1, ledCount * 16 / 50);
+	const int vertical = qMax(1, (ledCount - 2 * horizontal) / 2);
+	const int top = ledCount - horizontal - 2 * vertical;
+	const double depth = 0.08;
+
+	QJsonArray leds;
+	const auto append = [&](double hmin, double hmax, double vmin, double vmax) {
+		leds.append(QJsonObject{ { "hmin", hmin }, { "hmax", hmax }, { "vmin", vmin }, { "vmax", vmax } });
+	};
+
+	for (int i = 0; i < top; ++i)
+		append(double(i) / top, double(i + 1) / top, 0.0, depth);
+	for (int i = 0; i < vertical; ++i)
+		append(1.0 - depth, 1.0, double(i) / vertical, double(i + 1) / vertical);
+	for (int i = horizontal - 1; i >= 0; --i)
+		append(double(i) / horizontal, double(i + 1) / horizontal, 1.0 - depth, 1.0);
+	for (int i = vertical - 1; i >= 0; --i)
+		append(0.0, depth, double(i) / vertical, double(i + 1) / vertical);
+
+	return leds;
+}
+
+///
+/// Creates a frame in the source format, each variant differs in all pixels
+///
+QByteArray createFrame(int width, int height, PixelFormat pixelFormat, int variant, int& lineLength)
+{
+	int frameSize;
+	switch (pixelFormat)
+	{
+	case PixelFormat::YUYV:
+	case PixelFormat::UYVY:
+	case PixelFormat::BGR16:
+		lineLength = width * 2;
+		frameSize = lineLength * height;
+		break;
+	case PixelFormat::BGR24:
+		lineLength = width * 3;
+		frameSize = lineLength * height;
+		break;
+	case PixelFormat::NV12:
+	case PixelFormat::I420:
+		lineLength = width;
+		frameSize = width * height * 3 / 2;
+		break;
+	default:
+		lineLength = width * 4;
+		frameSize = lineLength * height;
+		break;
+	}
+
+	QByteArray frame(frameSize, 0);
+	for (int i = 0; i < frameSize; ++i)
+	{
+		frame[i] = static_cast<char>((i * 7 + variant * 31 + i / lineLength) & 0xFF);
+	}
+	return frame;
+}
+
+} // namespace
+
+// count the heap allocations of all threads
+void* operator new(size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* pointer = std::malloc(size == 0 ? 1 : size))
+	{
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	std::free(pointer);
+}
+
+int main(int argc, char** argv)
+{
+	QCoreApplication app(argc, argv);
+	Logger::setLogLevel(Logger::ERRORR);
+
+	const int frames = (argc > 1) ? QString(argv[1]).toInt() : 1000;
+	const int width = (argc > 2) ? QString(argv[2]).toInt() : 1920;
+	const int height = (argc > 3) ? QString(argv[3]).toInt() : 1080;
+	const QString format = (argc > 4) ? QString(argv[4]) : QString("yuyv");
+	const int ledCount = (argc > 5) ? QString(argv[5]).toInt() : 200;
+	const bool smoothing = (argc > 6) && QString(argv[6]).toInt() != 0;
+
+	PixelFormat pixelFormat = parsePixelFormat(format);
+#ifdef HAVE_TURBO_JPEG
+	if (pixelFormat == PixelFormat::MJPEG)
+	{
+		std::cerr << "MJPEG frames are not supported" << std::endl;
+		return 1;
+	}
+#endif
+
+	QTemporaryDir tempDir;
+	if (!tempDir.isValid())
+	{
+		std::cerr << "Failed to create the database directory" << std::endl;
+		return 1;
+	}
+	DBManager dbManager;
+	dbManager.setRootPath(tempDir.path());
+
+	HyperionTestInstance::registerDevice();
+
+	// the instance reads its settings from the database
+	{
+		SettingsManager settingsManager(0);
+		QJsonObject config = settingsManager.getSettings();
+		config["leds"] = createLayout(ledCount);
+		config["device"] = HyperionTestInstance::deviceConfig(ledCount);
+
+		QJsonObject smoothingConfig = config["smoothing"].toObject();
+		smoothingConfig["enable"] = smoothing;
+		config["smoothing"] = smoothingConfig;
+
+		for (const QString& effect : { QString("foregroundEffect"), QString("backgroundEffect") })
+		{
+			QJsonObject effectConfig = config[effect].toObject();
+			effectConfig["enable"] = false;
+			config[effect] = effectConfig;
+		}
+
+		if (!settingsManager.saveSettings(config, true))
+		{
+			std::cerr << "Failed to save the settings" << std::endl;
+			return 1;
+		}
+	}
+
+	Hyperion* hyperion = HyperionTestInstance::createInstance();
+	if (!HyperionTestInstance::waitFor([&]() { return HyperionTestInstance::isDeviceEnabled(hyperion); }, 5000))
+	{
+		std::cerr << "The LED device was not enabled" << std::endl;
+		return 1;
+	}
+
+	// the source frames are prepared upfront, frames in RGB are fed without conversion
+	ImageResampler resampler;
+	std::vector<QByteArray> sources;
+	std::vector<Image<ColorRgb>> rgbSources;
+	int lineLength = 0;
+	for (int variant = 0; variant < FRAME_VARIANTS; ++variant)
+	{
+		if (pixelFormat == PixelFormat::NO_CHANGE)
+		{
+			Image<ColorRgb> image(static_cast<unsigned>(width), static_cast<unsigned>(height));
+			resampler.processImage(reinterpret_cast<const uint8_t*>(createFrame(width, height, PixelFormat::RGB32, variant, lineLength).constData()), width, height, lineLength, PixelFormat::RGB32, image);
+			rgbSources.push_back(image);
+		}
+		else
+		{
+			sources.push_back(createFrame(width, height, pixelFormat, variant, lineLength));
+		}
+	}
+
+	const auto feed = [&](int frame) {
+		if (pixelFormat == PixelFormat::NO_CHANGE)
+		{
+			return hyperion->setInputImage(PRIORITY, rgbSources[static_cast<size_t>(frame % FRAME_VARIANTS)]);
+		}
+
+		Image<ColorRgb> image;
+		{
+			Metrics::ScopedTimer timer(Metrics::DECODE);
+			resampler.processImage(reinterpret_cast<const uint8_t*>(sources[static_cast<size_t>(frame % FRAME_VARIANTS)].constData()), width, height, lineLength, pixelFormat, image);
+		}
+		return hyperion->setInputImage(PRIORITY, image);
+	};
+
+	// the first frame makes the priority visible
+	hyperion->registerInput(PRIORITY, hyperion::COMP_V4L, "Benchmark");
+	feed(0);
+	if (!HyperionTestInstance::waitFor([&]() { return hyperion->getCurrentPriority() == PRIORITY; }, 5000))
+	{
+		std::cerr << "The input did not become visible" << std::endl;
+		return 1;
+	}
+	HyperionTestInstance::waitFor([&]() { return LedDeviceMemory::writes().load() > 0; }, 1000);
+
+	const int writesBefore = LedDeviceMemory::writes().load();
+	const quint64 allocationsBefore = allocations.load();
+	QElapsedTimer timer;
+	timer.start();
+
+	for (int frame = 1; frame <= frames; ++frame)
+	{
+		if (!feed(frame))
+		{
+			std::cerr << "Frame " << frame << " was rejected" << std::endl;
+			return 1;
+		}
+		QCoreApplication::processEvents();
+	}
+	const qint64 feedNs = timer.nsecsElapsed();
+
+	// the device thread writes the remaining queued frames, with smoothing it writes at its own rate
+	int lastWrites = -1;
+	qint64 writeNs = feedNs;
+	while (LedDeviceMemory::writes().load() != lastWrites)
+	{
+		lastWrites = LedDeviceMemory::writes().load();
+		writeNs = timer.nsecsElapsed();
+		if (lastWrites - writesBefore >= frames)
+		{
+			break;
+		}
+		HyperionTestInstance::waitFor([]() { return false; }, 100);
+	}
+	const quint64 frameAllocations = allocations.load() - allocationsBefore;
+	const int writes = lastWrites - writesBefore;
+
+	QJsonObject result;
+	result["frames"] = frames;
+	result["width"] = width;
+	result["height"] = height;
+	result["pixel_format"] = (pixelFormat == PixelFormat::NO_CHANGE) ? QString("rgb") : pixelFormatToString(pixelFormat);
+	result["leds"] = ledCount;
+	result["smoothing"] = smoothing;
+	result["feed_fps"] = frames * 1e9 / feedNs;
+	result["device_writes"] = writes;
+	result["device_fps"] = writes * 1e9 / writeNs;
+	result["allocations"] = static_cast<double>(frameAllocations);
+	result["allocations_per_frame"] = static_cast<double>(frameAllocations) / frames;
+	result["metrics"] = Metrics::toJson();
+
+	delete hyperion;
+
+	// the JSON is not interleaved with log messages
+	Logger::flush();
+	std::cout << QJsonDocument(result).toJson().toStdString() << std::endl;
+
+	return 0;
+}
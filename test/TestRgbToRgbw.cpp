@@ -0,0 +1,90 @@
+// STL includes
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// Qt includes
+#include <QElapsedTimer>
+
+// Hyperion includes
+#include <utils/RgbToRgbw.h>
+
+// Compares the RGBW output stage with the reference conversion for all RGB colors and white algorithms
+// and reports the conversion time per frame.
+// Usage: test_rgbtorgbw [leds]
+
+int main(int argc, char** argv)
+{
+	const int leds = (argc > 1) ? QString(argv[1]).toInt() : 10000;
+
+	const std::pair<const char*, RGBW::WhiteAlgorithm> algorithms[] = {
+		{ "subtract_minimum", RGBW::WhiteAlgorithm::SUBTRACT_MINIMUM },
+		{ "sub_min_warm_adjust", RGBW::WhiteAlgorithm::SUB_MIN_WARM_ADJUST },
+		{ "sub_min_cool_adjust", RGBW::WhiteAlgorithm::SUB_MIN_COOL_ADJUST },
+		{ "white_off", RGBW::WhiteAlgorithm::WHITE_OFF } };
+
+	std::vector<ColorRgb> frame(leds);
+	for (int i = 0; i < leds; ++i)
+	{
+		frame[i] = ColorRgb{ uint8_t(i * 7), uint8_t(i * 13), uint8_t(i * 29) };
+	}
+	std::vector<uint8_t> output(leds * sizeof(ColorRgbw));
+
+	int mismatches = 0;
+	for (const auto& algorithm : algorithms)
+	{
+		RGBW::RgbwConverter converter(algorithm.second);
+
+		// one row of blue values per red/green combination
+		std::vector<ColorRgb> row(256);
+		std::vector<uint8_t> rowOutput(256 * sizeof(ColorRgbw));
+		for (int red = 0; red < 256; ++red)
+		{
+			for (int green = 0; green < 256; ++green)
+			{
+				for (int blue = 0; blue < 256; ++blue)
+				{
+					row[blue] = ColorRgb{ uint8_t(red), uint8_t(green), uint8_t(blue) };
+				}
+				converter.convert(row.data(), row.size(), rowOutput.data());
+
+				for (int blue = 0; blue < 256; ++blue)
+				{
+					ColorRgbw expected;
+					RGBW::Rgb_to_Rgbw(row[blue], &expected, algorithm.second);
+					const uint8_t* converted = &rowOutput[blue * sizeof(ColorRgbw)];
+					if (converted[0] != expected.red || converted[1] != expected.green || converted[2] != expected.blue || converted[3] != expected.white)
+					{
+						++mismatches;
+					}
+				}
+			}
+		}
+
+		const int runs = 100;
+		ColorRgbw reference;
+		QElapsedTimer timer;
+		timer.start();
+		for (int run = 0; run < runs; ++run)
+		{
+			for (int i = 0; i < leds; ++i)
+			{
+				RGBW::Rgb_to_Rgbw(frame[i], &reference, algorithm.second);
+				memcpy(&output[i * sizeof(ColorRgbw)], &reference, sizeof(ColorRgbw));
+			}
+		}
+		const qint64 referenceTime = timer.nsecsElapsed() / runs;
+
+		timer.restart();
+		for (int run = 0; run < runs; ++run)
+		{
+			converter.convert(frame.data(), frame.size(), output.data());
+		}
+		const qint64 converterTime = timer.nsecsElapsed() / runs;
+
+		std::cout << algorithm.first << ": " << leds << " LEDs, reference " << referenceTime / 1000 << " us, converter " << converterTime / 1000 << " us" << std::endl;
+	}
+
+	std::cout << mismatches << " mismatching colors" << std::endl;
+	return (mismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+// STL includes
+#include <iostream>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QTemporaryDir>
+
+// Hyperion includes
+#include <db/DBManager.h>
+#include <hyperion/SettingsManager.h>
+#include <utils/Logger.h>
+
+// Measures the startup of the settings of the global and N instances (like hyperiond does), on a new and an existing database.
+// Each scenario runs in a new process, the settings of a previous run are not cached in memory.
+// Usage: test_settingsmanagerstartup [instances] [database directory]
+
+static const int READ_ITERATIONS = 100;
+
+static qint64 startup(int instances, bool readSettings)
+{
+	QElapsedTimer timer;
+	timer.start();
+
+	QList<SettingsManager*> managers;
+	managers << new SettingsManager(GLOABL_INSTANCE_ID);
+	for (int instance = 0; instance < instances; ++instance)
+	{
+		managers << new SettingsManager(static_cast<quint8>(instance));
+	}
+
+	// components read their settings on startup and on each settings update
+	if (readSettings)
+	{
+		for (int i = 0; i < READ_ITERATIONS; ++i)
+		{
+			for (SettingsManager* manager : qAsConst(managers))
+			{
+				for (int type = settings::BGEFFECT; type < settings::INVALID; ++type)
+				{
+					manager->getSetting(static_cast<settings::type>(type));
+				}
+			}
+		}
+	}
+
+	qDeleteAll(managers);
+	return timer.nsecsElapsed() / 1000000;
+}
+
+/// Run a scenario in a new process of this test, its result is printed as the only output
+static QString runScenario(const QString& scenario, int instances, const QString& path)
+{
+	QProcess process;
+	process.start(QCoreApplication::applicationFilePath(), { "--scenario", scenario, QString::number(instances), path });
+	if (!process.waitForFinished(-1) || process.exitCode() != 0)
+	{
+		return "failed";
+	}
+	return QString::fromLocal8Bit(process.readAllStandardOutput()).trimmed().section('\n', -1) + " ms";
+}
+
+int main(int argc, char** argv)
+{
+	QCoreApplication app(argc, argv);
+	Logger::setLogLevel(Logger::WARNING);
+
+	// a single scenario on the given database: --scenario <new|existing|reads> <instances> <database directory>
+	if (argc == 5 && QString(argv[1]) == "--scenario")
+	{
+		Logger::setLogLevel(Logger::OFF);
+		DBManager dbManager;
+		dbManager.setRootPath(QString(argv[4]));
+		std::cout << startup(QString(argv[3]).toInt(), QString(argv[2]) == "reads") << std::endl;
+		return 0;
+	}
+
+	const int instances = (argc > 1) ? QString(argv[1]).toInt() : 4;
+
+	// the database is created in a temporary directory by default, pass a directory on the device under test (e.g. an SD card)
+	QTemporaryDir tempDir(argc > 2 ? QString(argv[2]) + "/hyperion-test-XXXXXX" : QString());
+	if (!tempDir.isValid())
+	{
+		std::cerr << "Failed to create the database directory" << std::endl;
+		return 1;
+	}
+
+	std::cout << "Settings of " << instances << " instances + global" << std::endl;
+	std::cout << "  new database:      " << runScenario("new", instances, tempDir.path()).toStdString() << std::endl;
+	std::cout << "  existing database: " << runScenario("existing", instances, tempDir.path()).toStdString() << std::endl;
+	std::cout << "  with " << READ_ITERATIONS << " reads of all settings: " << runScenario("reads", instances, tempDir.path()).toStdString() << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,146 @@
+// STL includes
+#include <iostream>
+#include <vector>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+// Hyperion includes
+#include <db/DBManager.h>
+#include <hyperion/SettingsManager.h>
+#include <utils/Logger.h>
+
+#include "HyperionTestInstance.h"
+
+// Feeds the same frame repeatedly: unchanged frames of the visible priority must not be written again,
+// after a color settings change the same frame has to be processed and written with the new adjustment.
+// Usage: test_unchangedframes
+
+namespace {
+
+const int PRIORITY = 100;
+const int LED_COUNT = 4;
+const int REPEATS = 10;
+
+QJsonObject withBrightness(QJsonObject config, int brightness)
+{
+	QJsonObject color = config["color"].toObject();
+	QJsonArray adjustments = color["channelAdjustment"].toArray();
+	QJsonObject adjustment = adjustments[0].toObject();
+	adjustment["brightness"] = brightness;
+	adjustments[0] = adjustment;
+	color["channelAdjustment"] = adjustments;
+	config["color"] = color;
+	return config;
+}
+
+/// Feed the image several times and let the device thread write
+int feedRepeatedly(Hyperion* hyperion, const Image<ColorRgb>& image)
+{
+	const int before = LedDeviceMemory::writes().load();
+	for (int i = 0; i < REPEATS; ++i)
+	{
+		hyperion->setInputImage(PRIORITY, image);
+		QCoreApplication::processEvents();
+	}
+	HyperionTestInstance::waitFor([]() { return false; }, 200);
+	return LedDeviceMemory::writes().load() - before;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	QCoreApplication app(argc, argv);
+	Logger::setLogLevel(Logger::ERRORR);
+
+	QTemporaryDir tempDir;
+	if (!tempDir.isValid())
+	{
+		std::cerr << "Failed to create the database directory" << std::endl;
+		return 1;
+	}
+	DBManager dbManager;
+	dbManager.setRootPath(tempDir.path());
+
+	HyperionTestInstance::registerDevice();
+
+	// the instance reads its settings from the database
+	{
+		SettingsManager settingsManager(0);
+		QJsonObject config = settingsManager.getSettings();
+
+		QJsonArray leds;
+		for (int i = 0; i < LED_COUNT; ++i)
+		{
+			leds.append(QJsonObject{ { "hmin", double(i) / LED_COUNT }, { "hmax", double(i + 1) / LED_COUNT }, { "vmin", 0.0 }, { "vmax", 1.0 } });
+		}
+		config["leds"] = leds;
+		config["device"] = HyperionTestInstance::deviceConfig(LED_COUNT);
+
+		for (const QString& component : { QString("smoothing"), QString("foregroundEffect"), QString("backgroundEffect"), QString("blackborderdetector") })
+		{
+			QJsonObject componentConfig = config[component].toObject();
+			componentConfig["enable"] = false;
+			config[component] = componentConfig;
+		}
+
+		if (!settingsManager.saveSettings(withBrightness(config, 100), true))
+		{
+			std::cerr << "Failed to save the settings" << std::endl;
+			return 1;
+		}
+	}
+
+	Hyperion* hyperion = HyperionTestInstance::createInstance();
+	if (!HyperionTestInstance::waitFor([&]() { return HyperionTestInstance::isDeviceEnabled(hyperion); }, 5000))
+	{
+		std::cerr << "The LED device was not enabled" << std::endl;
+		return 1;
+	}
+
+	Image<ColorRgb> image(64, 36, ColorRgb{ 200, 160, 120 });
+	hyperion->registerInput(PRIORITY, hyperion::COMP_V4L, "Test");
+	hyperion->setInputImage(PRIORITY, image);
+	if (!HyperionTestInstance::waitFor([&]() { return hyperion->getCurrentPriority() == PRIORITY && LedDeviceMemory::writes().load() > 0; }, 5000))
+	{
+		std::cerr << "The first frame was not written" << std::endl;
+		return 1;
+	}
+	HyperionTestInstance::waitFor([]() { return false; }, 200);
+
+	// the frame becomes visible with the first update, it is processed once more before it is known as written
+	feedRepeatedly(hyperion, image);
+	const std::vector<ColorRgb> before = LedDeviceMemory::lastColors();
+
+	const int unchangedWrites = feedRepeatedly(hyperion, image);
+	std::cout << "Unchanged frames: " << unchangedWrites << " of " << REPEATS << " written" << std::endl;
+
+	// a copy with other pixels is a new frame
+	Image<ColorRgb> changed(64, 36, ColorRgb{ 10, 20, 30 });
+	const int changedWrites = feedRepeatedly(hyperion, changed) + feedRepeatedly(hyperion, image);
+	std::cout << "Changed frames: " << changedWrites << " written" << std::endl;
+
+	// the same frame after a color change
+	if (!hyperion->saveSettings(withBrightness(hyperion->getQJsonConfig(), 20), true))
+	{
+		std::cerr << "Failed to change the color settings" << std::endl;
+		return 1;
+	}
+	HyperionTestInstance::waitFor([]() { return false; }, 200);
+	const int settingsWrites = feedRepeatedly(hyperion, image);
+	const std::vector<ColorRgb> after = LedDeviceMemory::lastColors();
+	std::cout << "Unchanged frames after a color change: " << settingsWrites << " of " << REPEATS << " written" << std::endl;
+
+	delete hyperion;
+
+	const bool skipped = (unchangedWrites == 0);
+	const bool changedWritten = (changedWrites >= 2);
+	const bool reset = (settingsWrites == 1 && after != before);
+	std::cout << "Skip: " << (skipped ? "OK" : "FAILED") << ", changed frames: " << (changedWritten ? "OK" : "FAILED") << ", reset on settings change: " << (reset ? "OK" : "FAILED") << std::endl;
+
+	return (skipped && changedWritten && reset) ? 0 : 1;
+}